@@ -22,4 +22,23 @@
     recordreplay::Assert(format, ##__VA_ARGS__); \
   static_assert(true, "require semicolon")
 
+// Features which are checked on hot paths. These are resolved once when
+// recording/replaying starts, see recordreplay::Feature.
+#define RECORD_REPLAY_FEATURE_LIST(V)                 \
+  V(Values, "values")                                 \
+  V(GCChanges, "gc-changes")                          \
+  V(PointerIds, "pointer-ids")                        \
+  V(EmitOpcodes, "emit-opcodes")                      \
+  V(NoEvalCache, "no-eval-cache")                     \
+  V(Interrupts, "interrupts")                         \
+  V(ValueSerializer, "ValueSerializer")               \
+  V(ReplayCode, "replay-code")                        \
+  V(RegisterScripts, "register-scripts")              \
+  V(PassThroughEvents, "pass-through-events")         \
+  V(DisallowEvents, "disallow-events")                \
+  V(NoStreamedScriptCache, "no-streamed-script-cache") \
+  V(NoCountUsage, "no-count-usage")                   \
+  V(NoAsmWasm, "no-asm-wasm")                         \
+  V(LeakReferences, "leak-references")
+
 #endif  // INCLUDE_REPLAYIO_MACROS_H_
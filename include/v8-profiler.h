@@ -613,7 +613,8 @@ class V8_EXPORT OutputStream {
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
 
   /** Returns the root node of the heap graph. */
@@ -663,6 +664,20 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * The binary format has the same contents and is faster to write for
+   * large heaps. Numbers are unsigned LEB128 varints, and strings are a
+   * varint byte length followed by UTF-8 bytes. It consists of:
+   *
+   *  - The bytes "V8HS" and a format version, currently 1.
+   *  - The contents of the JSON snapshot object, followed by a zero byte.
+   *  - The nodes, edges, trace_function_infos, samples and locations arrays,
+   *    each written as its number of entries followed by their fields.
+   *  - Whether there is a trace tree, and if so its root node. Trace nodes
+   *    are written as their fields, the number of children and the children.
+   *  - The number of strings followed by the strings.
+   *
+   * tools/heap-snapshot-binary-to-json.py converts it to the JSON format.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
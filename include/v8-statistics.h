@@ -139,6 +139,13 @@ class V8_EXPORT HeapStatistics {
    */
   size_t does_zap_garbage() { return does_zap_garbage_; }
 
+  /**
+   * Returns an estimate of the bytes of old space and code memory which are
+   * currently backed by transparent huge pages. This is only tracked with
+   * --transparent-huge-pages on Linux and is 0 otherwise.
+   */
+  size_t huge_page_backed_memory() { return huge_page_backed_memory_; }
+
  private:
   size_t total_heap_size_;
   size_t total_heap_size_executable_;
@@ -154,6 +161,7 @@ class V8_EXPORT HeapStatistics {
   size_t number_of_detached_contexts_;
   size_t total_global_handles_size_;
   size_t used_global_handles_size_;
+  size_t huge_page_backed_memory_;
 
   friend class V8;
   friend class Isolate;
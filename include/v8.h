@@ -103,6 +103,22 @@ static bool IsARMRecording();
 static bool FeatureEnabled(const char* feature, const char* subfeature = nullptr);
 static bool HasDisabledFeatures();
 
+// Features which can be checked without calling into the driver. Whether each
+// feature is enabled is fixed when recording/replaying starts. If the driver
+// has disabled any features, a subfeature is resolved by the driver the first
+// time it is checked and cached afterwards, so checking one only costs a hash
+// and a string comparison.
+enum class Feature {
+#define DECLARE_RECORD_REPLAY_FEATURE(Name, String) k##Name,
+  RECORD_REPLAY_FEATURE_LIST(DECLARE_RECORD_REPLAY_FEATURE)
+#undef DECLARE_RECORD_REPLAY_FEATURE
+  kCount
+};
+
+static bool IsRecordingOrReplaying(Feature feature,
+                                   const char* subfeature = nullptr);
+static bool FeatureEnabled(Feature feature, const char* subfeature = nullptr);
+
 static char* ReadAssetFileContents(const char* path, size_t* size);
 static void Print(const char* format, ...);
 static void Diagnostic(const char* format, ...);
@@ -5,12 +5,14 @@
 #include "src/api/api.h"
 
 #include <algorithm>  // For min
+#include <atomic>
 #include <cinttypes>
 #include <cmath>      // For isnan.
 #include <cstdio>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>  // For move
 #include <vector>
 
@@ -33,6 +35,7 @@
 #include "src/base/functional.h"
 #include "src/base/logging.h"
 #include "src/base/platform/memory.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
 #include "src/base/safe_conversions.h"
@@ -6420,7 +6423,8 @@ HeapStatistics::HeapStatistics()
       peak_malloced_memory_(0),
       does_zap_garbage_(false),
       number_of_native_contexts_(0),
-      number_of_detached_contexts_(0) {}
+      number_of_detached_contexts_(0),
+      huge_page_backed_memory_(0) {}
 
 HeapSpaceStatistics::HeapSpaceStatistics()
     : space_name_(nullptr),
@@ -9226,6 +9230,7 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
   heap_statistics->number_of_detached_contexts_ =
       heap->NumberOfDetachedContexts();
   heap_statistics->does_zap_garbage_ = heap->ShouldZapGarbage();
+  heap_statistics->huge_page_backed_memory_ = heap->HugePageBackedMemory();
 
 #if V8_ENABLE_WEBASSEMBLY
   heap_statistics->malloced_memory_ +=
@@ -10492,12 +10497,17 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kBinary,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
-  serializer.Serialize(stream);
+  if (format == kBinary) {
+    serializer.SerializeBinary(stream);
+  } else {
+    serializer.Serialize(stream);
+  }
 }
 
 // static
@@ -10790,6 +10800,21 @@ static bool gARMRecording;
 static bool gHasDisabledFeatures;
 static bool gAssertsDisabled;
 
+static_assert(static_cast<int>(recordreplay::Feature::kCount) <= 32,
+              "Feature bits must fit in gRecordingOrReplayingFeatures");
+
+// Bit for each recordreplay::Feature which is enabled.
+static uint32_t gEnabledFeatures = ~0u;
+
+// Same as gEnabledFeatures while recording or replaying, and zero otherwise.
+static uint32_t gRecordingOrReplayingFeatures;
+
+static const char* gRecordReplayFeatureNames[] = {
+#define RECORD_REPLAY_FEATURE_NAME(Name, String) String,
+  RECORD_REPLAY_FEATURE_LIST(RECORD_REPLAY_FEATURE_NAME)
+#undef RECORD_REPLAY_FEATURE_NAME
+};
+
 typedef char* (CommandCallbackRaw)(const char* params);
 
 #define ForEachRecordReplaySymbol(Macro)                                      \
@@ -10928,6 +10953,21 @@ ForEachRecordReplaySymbol(DeclareRecordReplaySymbol)
 ForEachRecordReplaySymbolVoid(DeclareRecordReplaySymbolVoid)
 #undef DeclareRecordReplaySymbolVoid
 
+// Driver symbols which might not be present in older drivers. These are null
+// if they could not be found.
+#define ForEachRecordReplayOptionalSymbol(Macro)                              \
+  Macro(RecordReplayRegisterInstrumentationKind, (const char* kind), int)     \
+  Macro(RecordReplayOnInstrumentRaw,                                          \
+        (int kind, int script_id, int function_start, int offset), void)      \
+  Macro(RecordReplaySetChangeFunctionInstrumentCallback,                      \
+        (void (*callback)(int script_id, int function_start, bool enabled)),  \
+        void)
+
+#define DeclareRecordReplayOptionalSymbol(Name, Params, ReturnType)           \
+  static ReturnType (*g##Name) Params;
+ForEachRecordReplayOptionalSymbol(DeclareRecordReplayOptionalSymbol)
+#undef DeclareRecordReplayOptionalSymbol
+
 namespace internal {
 
 bool gRecordReplayHasCheckpoint;
@@ -11029,7 +11069,15 @@ extern "C" uint64_t* V8RecordReplayGetProgressCounter() {
   return gProgressCounter;
 }
 
-bool gRecordReplayInstrumentationEnabled;
+// Whether instrumentation callbacks should be invoked. This is pointer sized
+// so that unoptimized code can test it inline and skip the runtime call.
+intptr_t gRecordReplayInstrumentationEnabled;
+
+// Number of live functions which have instrumentation callbacks enabled
+// individually, see RecordReplayChangeFunctionInstrument. When instrumentation
+// isn't enabled everywhere, unoptimized code only checks whether the current
+// function is instrumented when this is non-zero.
+intptr_t gRecordReplayInstrumentedFunctions;
 
 void RecordReplayChangeInstrument(bool enabled) {
   CHECK(!enabled || recordreplay::IsReplaying());
@@ -11086,6 +11134,39 @@ void RecordReplayInstrument(const char* kind, const char* function, int function
   gRecordReplayOnInstrument(kind, function, function_index);
 }
 
+// Instrumentation kinds which have been registered with the driver, for use
+// with the integer instrumentation callback.
+static std::unordered_map<std::string, int>* gInstrumentationKindIds;
+
+// Get the driver's ID for an instrumentation kind, or -1 if the driver does
+// not support the integer instrumentation callback.
+int RecordReplayInstrumentationKindId(const char* kind) {
+  CHECK(IsMainThread());
+  if (!gRecordReplayOnInstrumentRaw) {
+    return -1;
+  }
+  if (!gInstrumentationKindIds) {
+    gInstrumentationKindIds = new std::unordered_map<std::string, int>();
+  }
+  auto iter = gInstrumentationKindIds->find(kind);
+  if (iter != gInstrumentationKindIds->end()) {
+    return iter->second;
+  }
+  int id = gRecordReplayRegisterInstrumentationKind(kind);
+  CHECK_GE(id, 0);
+  gInstrumentationKindIds->emplace(kind, id);
+  return id;
+}
+
+void RecordReplayInstrumentRaw(int kind_id, int script_id, int function_start,
+                               int function_index) {
+  gRecordReplayOnInstrumentRaw(kind_id, script_id, function_start,
+                               function_index);
+}
+
+extern void RecordReplayChangeFunctionInstrument(int script_id,
+                                                 int function_start,
+                                                 bool enabled);
 extern void TrackObjectsCallback(bool track_objects);
 extern void RecordReplayGetPossibleBreakpointsCallback(const char* source_id);
 
@@ -11112,8 +11193,10 @@ bool gRecordReplayEnableDependencyGraph;
 bool gRecordReplayAssertDependencyGraph;
 
 // Enable various checks when advancing the progress counter. Set via the
-// environment, or when events are disallowed on the main thread.
-int gRecordReplayCheckProgress;
+// environment, or when events are disallowed on the main thread. This is
+// pointer sized so that generated code can test it with a single load when
+// deciding whether to take the progress counter slow path.
+intptr_t gRecordReplayCheckProgress;
 
 // Only finish recordings if there were interesting sources loaded
 // into the process.
@@ -11288,13 +11371,111 @@ bool RecordReplayAssertValues(const std::string& url) {
 
 } // namespace internal
 
+static uint32_t RecordReplayFeatureBit(recordreplay::Feature feature) {
+  return 1u << static_cast<int>(feature);
+}
+
 bool recordreplay::FeatureEnabled(const char* feature, const char* subfeature) {
   if (!gHasDisabledFeatures) {
     return true;
   }
+  // Features in the enum were resolved at startup. Subfeatures still need to
+  // be checked by the driver.
+  if (!subfeature) {
+    for (int i = 0; i < static_cast<int>(Feature::kCount); i++) {
+      if (!strcmp(feature, gRecordReplayFeatureNames[i])) {
+        return FeatureEnabled(static_cast<Feature>(i));
+      }
+    }
+  }
   return gRecordReplayFeatureEnabled(feature, subfeature);
 }
 
+namespace {
+
+// Whether (feature, subfeature) pairs are enabled, as reported by the driver.
+// Each pair is resolved once and later checks only hash and compare the
+// subfeature string. Entries are never modified after they are published, and
+// keep their own copy of the subfeature so callers can pass strings which
+// don't outlive the call.
+class RecordReplaySubfeatureCache {
+ public:
+  bool IsEnabled(recordreplay::Feature feature, const char* subfeature) {
+    size_t start = Hash(feature, subfeature);
+    for (size_t i = 0; i < kCapacity; i++) {
+      Entry& entry = entries_[(start + i) % kCapacity];
+      const char* key = entry.subfeature.load(std::memory_order_acquire);
+      if (!key) {
+        return Insert(feature, subfeature);
+      }
+      if (entry.feature == feature && !strcmp(key, subfeature)) {
+        return entry.enabled;
+      }
+    }
+    return Resolve(feature, subfeature);
+  }
+
+ private:
+  static constexpr size_t kCapacity = 1024;
+
+  struct Entry {
+    std::atomic<const char*> subfeature{nullptr};
+    recordreplay::Feature feature = recordreplay::Feature::kCount;
+    bool enabled = false;
+  };
+
+  static size_t Hash(recordreplay::Feature feature, const char* subfeature) {
+    return base::hash_combine(
+        base::hash_range(subfeature, subfeature + strlen(subfeature)),
+        static_cast<size_t>(feature));
+  }
+
+  static bool Resolve(recordreplay::Feature feature, const char* subfeature) {
+    return gRecordReplayFeatureEnabled(
+        gRecordReplayFeatureNames[static_cast<int>(feature)], subfeature);
+  }
+
+  bool Insert(recordreplay::Feature feature, const char* subfeature) {
+    bool enabled = Resolve(feature, subfeature);
+    base::MutexGuard guard(&mutex_);
+    size_t start = Hash(feature, subfeature);
+    for (size_t i = 0; i < kCapacity; i++) {
+      Entry& entry = entries_[(start + i) % kCapacity];
+      const char* key = entry.subfeature.load(std::memory_order_relaxed);
+      if (!key) {
+        entry.feature = feature;
+        entry.enabled = enabled;
+        entry.subfeature.store(strdup(subfeature), std::memory_order_release);
+        break;
+      }
+      if (entry.feature == feature && !strcmp(key, subfeature)) {
+        break;
+      }
+    }
+    // When the table is full the result is not cached.
+    return enabled;
+  }
+
+  base::Mutex mutex_;
+  Entry entries_[kCapacity];
+};
+
+// Only allocated if there are disabled features.
+RecordReplaySubfeatureCache* gRecordReplaySubfeatureCache;
+
+}  // namespace
+
+bool recordreplay::FeatureEnabled(Feature feature, const char* subfeature) {
+  if (!(gEnabledFeatures & RecordReplayFeatureBit(feature))) {
+    return false;
+  }
+  // Subfeatures can only be disabled when the driver has disabled features.
+  if (!subfeature || !gHasDisabledFeatures) {
+    return true;
+  }
+  return gRecordReplaySubfeatureCache->IsEnabled(feature, subfeature);
+}
+
 extern "C" DLLEXPORT bool V8RecordReplayFeatureEnabled(const char* feature, const char* subfeature) {
   return recordreplay::FeatureEnabled(feature, subfeature);
 }
@@ -11333,6 +11514,31 @@ bool recordreplay::IsRecordingOrReplaying(const char* feature, const char* subfe
   return gRecordingOrReplaying && (!feature || FeatureEnabled(feature, subfeature));
 }
 
+bool recordreplay::IsRecordingOrReplaying(Feature feature,
+                                          const char* subfeature) {
+  if (!(gRecordingOrReplayingFeatures & RecordReplayFeatureBit(feature))) {
+    return false;
+  }
+  if (!subfeature || !gHasDisabledFeatures) {
+    return true;
+  }
+  return gRecordReplaySubfeatureCache->IsEnabled(feature, subfeature);
+}
+
+// Called once the driver's disabled features are known.
+static void RecordReplayInitializeFeatures() {
+  if (!gHasDisabledFeatures) {
+    return;
+  }
+  gRecordReplaySubfeatureCache = new RecordReplaySubfeatureCache();
+  for (int i = 0; i < static_cast<int>(recordreplay::Feature::kCount); i++) {
+    if (!gRecordReplayFeatureEnabled(gRecordReplayFeatureNames[i], nullptr)) {
+      gEnabledFeatures &=
+          ~RecordReplayFeatureBit(static_cast<recordreplay::Feature>(i));
+    }
+  }
+}
+
 extern "C" DLLEXPORT bool V8IsRecordingOrReplaying(const char* feature, const char* subfeature) {
   return recordreplay::IsRecordingOrReplaying(feature, subfeature);
 }
@@ -11574,7 +11780,7 @@ extern "C" DLLEXPORT bool V8RecordReplayAreAssertsDisabled() {
 }
 
 uintptr_t recordreplay::RecordReplayValue(const char* why, uintptr_t v) {
-  if (IsRecordingOrReplaying("values", why)) {
+  if (IsRecordingOrReplaying(Feature::kValues, why)) {
     return gRecordReplayValue(why, v);
   }
   return v;
@@ -11585,7 +11791,7 @@ extern "C" DLLEXPORT uintptr_t V8RecordReplayValue(const char* why, uintptr_t va
 }
 
 void recordreplay::RecordReplayBytes(const char* why, void* buf, size_t size) {
-  if (IsRecordingOrReplaying("values", why)) {
+  if (IsRecordingOrReplaying(Feature::kValues, why)) {
     gRecordReplayBytes(why, buf, size);
   }
 }
@@ -11603,7 +11809,7 @@ void recordreplay::RecordReplayString(const char* why, std::string& str) {
 }
 
 bool recordreplay::AreEventsDisallowed(const char* why) {
-  if (IsRecordingOrReplaying("disallow-events", why)) {
+  if (IsRecordingOrReplaying(Feature::kDisallowEvents, why)) {
     return gRecordReplayAreEventsDisallowed();
   }
   return false;
@@ -11614,7 +11820,7 @@ extern "C" DLLEXPORT bool V8RecordReplayAreEventsDisallowed(const char* why) {
 }
 
 bool recordreplay::AreEventsPassedThrough(const char* why) {
-  if (IsRecordingOrReplaying("pass-through-events", why)) {
+  if (IsRecordingOrReplaying(Feature::kPassThroughEvents, why)) {
     return gRecordReplayAreEventsPassedThrough();
   }
   return false;
@@ -11770,7 +11976,20 @@ extern "C" DLLEXPORT size_t V8RecordReplayCreateOrderedLock(const char* name) {
 
 void recordreplay::OrderedLock(int lock) {
   if (IsRecordingOrReplaying()) {
+    // When replaying the main thread might have to wait for a background
+    // thread which is next in line to acquire the lock. Let the heap know so
+    // that thread doesn't wait for a GC the main thread can't perform.
+    i::Isolate* isolate = nullptr;
+    if (IsReplaying() && IsMainThread()) {
+      isolate = i::Isolate::TryGetCurrent();
+    }
+    if (isolate) {
+      isolate->heap()->SetMainThreadWaitingOnOrderedLock(true);
+    }
     gRecordReplayOrderedLock(lock);
+    if (isolate) {
+      isolate->heap()->SetMainThreadWaitingOnOrderedLock(false);
+    }
   }
 }
 
@@ -11941,7 +12160,7 @@ void recordreplay::EndDependencyExecution() {
 }
 
 void recordreplay::RegisterPointer(const char* name, const void* ptr) {
-  if (IsRecordingOrReplaying("pointer-ids")) {
+  if (IsRecordingOrReplaying(Feature::kPointerIds)) {
     gRecordReplayRegisterPointerWithName(name, ptr);
   }
 }
@@ -11951,7 +12170,7 @@ extern "C" DLLEXPORT void V8RecordReplayRegisterPointer(const char* name, const
 }
 
 void recordreplay::UnregisterPointer(const void* ptr) {
-  if (IsRecordingOrReplaying("pointer-ids")) {
+  if (IsRecordingOrReplaying(Feature::kPointerIds)) {
     gRecordReplayUnregisterPointer(ptr);
   }
 }
@@ -11961,7 +12180,7 @@ extern "C" DLLEXPORT void V8RecordReplayUnregisterPointer(const void* ptr) {
 }
 
 int recordreplay::PointerId(const void* ptr) {
-  if (IsRecordingOrReplaying("pointer-ids")) {
+  if (IsRecordingOrReplaying(Feature::kPointerIds)) {
     return gRecordReplayPointerId(ptr);
   }
   return 0;
@@ -11972,7 +12191,7 @@ extern "C" DLLEXPORT int V8RecordReplayPointerId(const void* ptr) {
 }
 
 void* recordreplay::IdPointer(int id) {
-  CHECK(IsRecordingOrReplaying("pointer-ids"));
+  CHECK(IsRecordingOrReplaying(Feature::kPointerIds));
   return gRecordReplayIdPointer(id);
 }
 
@@ -12163,6 +12382,19 @@ static void RecordReplayLoadSymbol(void* handle, const char* name, T& function)
   CastPointer(sym, &function);
 }
 
+template <typename T>
+static void RecordReplayLoadOptionalSymbol(void* handle, const char* name,
+                                           T& function) {
+#if V8_OS_WIN
+  void* sym = (void*)(GetProcAddress((HMODULE)handle, name));
+#else
+  void* sym = dlsym(handle, name);
+#endif
+  if (sym) {
+    CastPointer(sym, &function);
+  }
+}
+
 static bool IsRecordingUnusable() {
   if (recordreplay::IsRecording()) {
     char* reason = gRecordReplayGetUnusableRecordingReason();
@@ -12300,10 +12532,22 @@ ForEachRecordReplaySymbol(LoadRecordReplaySymbol)
 ForEachRecordReplaySymbolVoid(LoadRecordReplaySymbolVoid)
 #undef LoadRecordReplaySymbolVoid
 
+#define LoadRecordReplayOptionalSymbol(Name, Params, ReturnType)           \
+  RecordReplayLoadOptionalSymbol(handle, #Name, g##Name);
+ForEachRecordReplayOptionalSymbol(LoadRecordReplayOptionalSymbol)
+#undef LoadRecordReplayOptionalSymbol
+
+  // Both halves of the integer instrumentation API must be present.
+  if (!gRecordReplayRegisterInstrumentationKind) {
+    gRecordReplayOnInstrumentRaw = nullptr;
+  }
+
   RecordReplayInitializeDisabledFeatures();
   gHasDisabledFeatures = gRecordReplayHasDisabledFeatures();
+  RecordReplayInitializeFeatures();
 
   gRecordingOrReplaying = V8RecordReplayFeatureEnabled("record-replay", nullptr);
+  gRecordingOrReplayingFeatures = gRecordingOrReplaying ? gEnabledFeatures : 0;
   InitMainThread();
 
   gAssertsDisabled = gRecordReplayAreAssertsDisabled();
@@ -12318,6 +12562,10 @@ ForEachRecordReplaySymbolVoid(LoadRecordReplaySymbolVoid)
   i::gProgressCounter = gRecordReplayProgressCounter();
 
   gRecordReplaySetChangeInstrumentCallback(i::RecordReplayChangeInstrument);
+  if (gRecordReplaySetChangeFunctionInstrumentCallback) {
+    gRecordReplaySetChangeFunctionInstrumentCallback(
+        i::RecordReplayChangeFunctionInstrument);
+  }
   gRecordReplaySetProgressCallback(i::RecordReplaySetTargetProgress);
   gRecordReplaySetProgressInterruptCallback(i::RecordReplayProgressInterruptCallback);
   gRecordReplayEnableProgressCheckpoints();
@@ -12381,6 +12629,19 @@ ForEachRecordReplaySymbolVoid(LoadRecordReplaySymbolVoid)
     i::FLAG_incremental_marking = false;
   }
 
+  // Incremental marking which is only started and advanced at allocation
+  // points, including the embedder's marking steps, can be used when both
+  // recording and replaying. This is experimental, and is enabled by
+  // disabling this feature.
+  if (!V8RecordReplayFeatureEnabled("no-deterministic-incremental-marking", nullptr)) {
+    i::v8_flags.deterministic_incremental_marking = true;
+    i::FLAG_incremental_marking = true;
+    i::FLAG_incremental_marking_task = false;
+    i::FLAG_concurrent_marking = false;
+    i::FLAG_parallel_marking = false;
+    i::v8_flags.cppheap_concurrent_marking = false;
+  }
+
   // For now the compilation cache is only used when recording.
   if (IsReplaying() || !V8RecordReplayFeatureEnabled("v8-flags-compilation-cache", nullptr)) {
     i::FLAG_compilation_cache = false;
@@ -33,6 +33,8 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 
 #include "src/base/platform/platform-posix.h"
 
@@ -802,6 +804,175 @@ int OS::GetCurrentThreadId() {
 #endif
 }
 
+#if V8_OS_LINUX
+namespace {
+// Values from <linux/mempolicy.h>, which isn't available everywhere.
+constexpr int kMpolPreferred = 1;
+// Nodes which can be named in a policy. Larger systems fall back to the
+// default policy.
+constexpr int kMaxNumaNodes = 64;
+using NumaNodeMask = uint64_t;
+}  // namespace
+#endif  // V8_OS_LINUX
+
+int OS::NumberOfNumaNodes() {
+#if V8_OS_LINUX
+  static const int number_of_nodes = [] {
+    // The file lists the possible nodes as ranges, e.g. "0-1,3". The highest
+    // node mentioned bounds the nodes threads can run on.
+    FILE* file = fopen("/sys/devices/system/node/possible", "r");
+    if (file == nullptr) return 1;
+    int max_node = 0;
+    int value = 0;
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+      if (c >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+      } else {
+        max_node = std::max(max_node, value);
+        value = 0;
+      }
+    }
+    max_node = std::max(max_node, value);
+    fclose(file);
+    return std::min(max_node + 1, kMaxNumaNodes);
+  }();
+  return number_of_nodes;
+#else
+  return 1;
+#endif
+}
+
+int OS::GetCurrentNumaNode() {
+#if V8_OS_LINUX && defined(__NR_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (syscall(__NR_getcpu, &cpu, &node, nullptr) != 0) return -1;
+  return static_cast<int>(node);
+#else
+  return -1;
+#endif
+}
+
+bool OS::SetPreferredNumaNode(void* address, size_t size, int node) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+#if V8_OS_LINUX && defined(__NR_mbind)
+  if (node < 0 || node >= kMaxNumaNodes) return false;
+  NumaNodeMask mask = NumaNodeMask{1} << node;
+  // The kernel ignores the last bit of |maxnode|.
+  const unsigned long max_node =  // NOLINT(runtime/int)
+      sizeof(mask) * CHAR_BIT + 1;
+  return syscall(__NR_mbind, address, size, kMpolPreferred, &mask, max_node,
+                 0) == 0;
+#else
+  return false;
+#endif
+}
+
+int OS::GetNumaNodeOfAddress(void* address) {
+#if V8_OS_LINUX && defined(__NR_move_pages)
+  void* page = reinterpret_cast<void*>(
+      RoundDown(reinterpret_cast<uintptr_t>(address), CommitPageSize()));
+  int status = -1;
+  // Without target nodes move_pages only reports where the page lives.
+  if (syscall(__NR_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0) {
+    return -1;
+  }
+  return status >= 0 ? status : -1;
+#else
+  return -1;
+#endif
+}
+
+size_t OS::HugePageSize() {
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  static const size_t huge_page_size = [] {
+    FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+                       "r");
+    if (file == nullptr) return size_t{0};
+    size_t size = 0;
+    if (fscanf(file, "%zu", &size) != 1) size = 0;
+    fclose(file);
+    // Huge pages must be made up of whole commit pages.
+    if (size % CommitPageSize() != 0) size = 0;
+    return size;
+  }();
+  return huge_page_size;
+#else
+  return 0;
+#endif
+}
+
+bool OS::AdviseHugePages(void* address, size_t size) {
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  const size_t huge_page_size = HugePageSize();
+  if (huge_page_size == 0) return false;
+  const uintptr_t start =
+      RoundUp(reinterpret_cast<uintptr_t>(address), huge_page_size);
+  const uintptr_t end =
+      RoundDown(reinterpret_cast<uintptr_t>(address) + size, huge_page_size);
+  if (start >= end) return false;
+  return madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) ==
+         0;
+#else
+  return false;
+#endif
+}
+
+size_t OS::GetHugePageBackedSize(const std::vector<MemoryRange>& ranges) {
+#if V8_OS_LINUX
+  if (ranges.empty()) return 0;
+  FILE* file = fopen("/proc/self/smaps", "r");
+  if (file == nullptr) return 0;
+
+  // Each mapping starts with a line in the /proc/self/maps format and is
+  // followed by "Key: value" lines, one of which counts the bytes backed by
+  // transparent huge pages. Mappings which only partially overlap |ranges|
+  // are accounted for proportionally.
+  const int kMaxLineLength = 2 * FILENAME_MAX;
+  std::unique_ptr<char[]> line = std::make_unique<char[]>(kMaxLineLength);
+  size_t result = 0;
+  uintptr_t vm_start = 0;
+  uintptr_t vm_end = 0;
+  size_t overlap = 0;
+  while (fgets(line.get(), kMaxLineLength, file) != nullptr) {
+    uintptr_t start;
+    uintptr_t end;
+    size_t huge_kb;
+    if (sscanf(line.get(), "%" V8PRIxPTR "-%" V8PRIxPTR " ", &start, &end) ==
+        2) {
+      vm_start = start;
+      vm_end = end;
+      overlap = 0;
+      for (const MemoryRange& range : ranges) {
+        const uintptr_t overlap_start = std::max(vm_start, range.start);
+        const uintptr_t overlap_end = std::min(vm_end, range.end);
+        if (overlap_start < overlap_end) overlap += overlap_end - overlap_start;
+      }
+    } else if (overlap > 0 &&
+               sscanf(line.get(), "AnonHugePages: %zu kB", &huge_kb) == 1) {
+      const size_t huge_bytes = huge_kb * 1024;
+      const size_t vm_size = vm_end - vm_start;
+      result += overlap == vm_size
+                    ? huge_bytes
+                    : static_cast<size_t>(static_cast<double>(huge_bytes) *
+                                          overlap / vm_size);
+    }
+    // Skip the rest of overlong lines, e.g. with long path names.
+    if (strchr(line.get(), '\n') == nullptr) {
+      int c;
+      do {
+        c = fgetc(file);
+      } while (c != EOF && c != '\n');
+    }
+  }
+  fclose(file);
+  return result;
+#else
+  return 0;
+#endif
+}
+
 void OS::ExitProcess(int exit_code) {
   // Use _exit instead of exit to avoid races between isolate
   // threads and static destructors.
@@ -479,6 +479,24 @@ void OS::SignalCodeMovingGC() { SB_NOTIMPLEMENTED(); }
 
 void OS::AdjustSchedulingParams() {}
 
+int OS::NumberOfNumaNodes() { return 1; }
+
+int OS::GetCurrentNumaNode() { return -1; }
+
+bool OS::SetPreferredNumaNode(void* address, size_t size, int node) {
+  return false;
+}
+
+int OS::GetNumaNodeOfAddress(void* address) { return -1; }
+
+size_t OS::HugePageSize() { return 0; }
+
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
+size_t OS::GetHugePageBackedSize(const std::vector<MemoryRange>& ranges) {
+  return 0;
+}
+
 std::vector<OS::MemoryRange> OS::GetFreeMemoryRangesWithin(
     OS::Address boundary_start, OS::Address boundary_end, size_t minimum_size,
     size_t alignment) {
@@ -301,6 +301,24 @@ class V8_BASE_EXPORT OS {
 
   static void AdjustSchedulingParams();
 
+  // Returns the number of NUMA nodes memory can be placed on. This is 1 on
+  // single-node machines and on platforms without NUMA support.
+  static int NumberOfNumaNodes();
+
+  // Returns the NUMA node the calling thread is currently running on, or -1
+  // if it can't be determined.
+  static int GetCurrentNumaNode();
+
+  // Asks the OS to back pages in the given range with memory from |node| when
+  // they are first touched. Pages which are already resident are not moved.
+  // Returns false if the preference could not be set.
+  V8_WARN_UNUSED_RESULT static bool SetPreferredNumaNode(void* address,
+                                                         size_t size, int node);
+
+  // Returns the NUMA node the resident page containing |address| lives on, or
+  // -1 if the page is not resident or this can't be determined.
+  static int GetNumaNodeOfAddress(void* address);
+
   using Address = uintptr_t;
 
   struct MemoryRange {
@@ -314,6 +332,18 @@ class V8_BASE_EXPORT OS {
       Address boundary_start, Address boundary_end, size_t minimum_size,
       size_t alignment);
 
+  // Returns the size of transparent huge pages, or 0 if they aren't
+  // supported.
+  static size_t HugePageSize();
+
+  // Advises the OS to back the huge page aligned part of the given range with
+  // transparent huge pages. Returns false if nothing was advised.
+  static bool AdviseHugePages(void* address, size_t size);
+
+  // Returns an estimate of how many bytes of |ranges| are currently backed by
+  // huge pages, or 0 if this can't be determined. |ranges| must not overlap.
+  static size_t GetHugePageBackedSize(const std::vector<MemoryRange>& ranges);
+
   [[noreturn]] static void ExitProcess(int exit_code);
 
   // Whether the platform supports mapping a given address in another location
@@ -353,7 +383,9 @@ class V8_BASE_EXPORT OS {
   friend class v8::base::PageAllocator;
   friend class v8::base::VirtualAddressSpace;
   friend class v8::base::VirtualAddressSubspace;
+  FRIEND_TEST(OS, PreferredNumaNode);
   FRIEND_TEST(OS, RemapPages);
+  FRIEND_TEST(OS, TransparentHugePages);
 
   static size_t AllocatePageSize();
 
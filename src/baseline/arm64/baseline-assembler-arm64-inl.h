@@ -585,6 +585,10 @@ void BaselineAssembler::AddSmi(Register lhs, Smi rhs) {
   }
 }
 
+void BaselineAssembler::AddPointer(Register output, Immediate value) {
+  __ Add(output, output, value);
+}
+
 void BaselineAssembler::Word32And(Register output, Register lhs, int rhs) {
   __ And(output, lhs, Immediate(rhs));
 }
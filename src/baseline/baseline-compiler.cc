@@ -63,6 +63,8 @@
 namespace v8 {
 namespace internal {
 
+extern bool gRecordReplayAssertProgress;
+
 namespace baseline {
 
 template <typename IsolateT>
@@ -2287,28 +2289,48 @@ void BaselineCompiler::VisitIncBlockCounter() {
 }
 
 void BaselineCompiler::VisitRecordReplayIncExecutionProgressCounter() {
-  // The optimized path is currently disabled.
-  // See https://linear.app/replay/issue/RUN-744
-  if ((true)/*gRecordReplayAssertProgress*/) {
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_ARM64
+  // Progress asserts are only collected by the runtime, and are enabled or
+  // disabled for the whole process before any code is compiled.
+  if (gRecordReplayAssertProgress) {
+    SaveAccumulatorScope accumulator_scope(&basm_);
     CallRuntime(Runtime::kRecordReplayAssertExecutionProgress,
                 __ FunctionOperand());
-  } else {
-    /*
+    return;
+  }
+
+  // Increment the counter inline, and only call into the runtime (which does
+  // the increment itself) when progress checks are enabled or the target
+  // progress is about to be reached.
+  Label runtime, done;
+  {
     BaselineAssembler::ScratchRegisterScope scratch_scope(&basm_);
-    Register reg1 = scratch_scope.AcquireScratch();
-    Register reg2 = scratch_scope.AcquireScratch();
-    __ Move(reg1, ExternalReference::record_replay_progress_counter());
-    __ Move(reg2, MemOperand(reg1, 0));
-    __ AddPointer(reg2, Immediate(1));
-    __ Move(MemOperand(reg1, 0), reg2);
-    __ Move(reg1, ExternalReference::record_replay_target_progress());
-    __ ComparePointer(reg2, MemOperand(reg1, 0));
-    Label done;
-    __ JumpIf(Condition::kNotEqual, &done, Label::kNear);
-    CallRuntime(Runtime::kRecordReplayTargetProgressReached);
-    __ Bind(&done);
-    */
+    Register address = scratch_scope.AcquireScratch();
+    Register value = scratch_scope.AcquireScratch();
+    __ Move(address, ExternalReference::record_replay_check_progress());
+    __ Move(value, MemOperand(address, 0));
+    __ JumpIfImmediate(Condition::kNotEqual, value, 0, &runtime);
+    __ Move(address, ExternalReference::record_replay_progress_counter());
+    __ Move(value, MemOperand(address, 0));
+    __ AddPointer(value, Immediate(1));
+    __ Move(address, ExternalReference::record_replay_target_progress());
+    __ JumpIfPointer(Condition::kEqual, value, MemOperand(address, 0),
+                     &runtime);
+    __ Move(address, ExternalReference::record_replay_progress_counter());
+    __ Move(MemOperand(address, 0), value);
+    __ Jump(&done);
+  }
+  __ Bind(&runtime);
+  {
+    SaveAccumulatorScope accumulator_scope(&basm_);
+    CallRuntime(Runtime::kRecordReplayAssertExecutionProgress,
+                __ FunctionOperand());
   }
+  __ Bind(&done);
+#else
+  CallRuntime(Runtime::kRecordReplayAssertExecutionProgress,
+              __ FunctionOperand());
+#endif
 }
 
 void BaselineCompiler::VisitReplayIncJsFrameDepth() {
@@ -2322,11 +2344,27 @@ void BaselineCompiler::VisitReplayIncJsFrameDepth() {
   masm_.cmpl(depth, Immediate(ThreadLocalTop::kReplayMaxJsFrameDepth));
   Label done;
   masm_.j(less, &done);
-  CallRuntime(Runtime::kThrowStackOverflow);
+  CallRuntime(Runtime::kRecordReplayThrowJsFrameDepthOverflow);
+  __ Trap();
+  __ Bind(&done);
+#elif V8_TARGET_ARCH_ARM64
+  BaselineAssembler::ScratchRegisterScope scratch_scope(&basm_);
+  Register address = scratch_scope.AcquireScratch();
+  Register depth = scratch_scope.AcquireScratch();
+  __ Move(address, ExternalReference::Create(
+                       IsolateAddressId::kReplayJsFrameDepthAddress,
+                       masm_.isolate()));
+  masm_.Ldr(depth.W(), MemOperand(address));
+  masm_.Add(depth.W(), depth.W(), Immediate(1));
+  masm_.Str(depth.W(), MemOperand(address));
+  masm_.Cmp(depth.W(), Immediate(ThreadLocalTop::kReplayMaxJsFrameDepth));
+  Label done;
+  masm_.B(lt, &done);
+  CallRuntime(Runtime::kRecordReplayThrowJsFrameDepthOverflow);
   __ Trap();
   __ Bind(&done);
 #else
-  FATAL("ReplayIncJsFrameDepth Baseline lowering is x64 only");
+  FATAL("ReplayIncJsFrameDepth Baseline lowering is x64/arm64 only");
 #endif
 }
 
@@ -2338,8 +2376,18 @@ void BaselineCompiler::VisitReplayDecJsFrameDepth() {
       IsolateAddressId::kReplayJsFrameDepthAddress, masm_.isolate());
   Operand depth = masm_.ExternalReferenceAsOperand(depth_ref, scratch);
   masm_.decl(depth);
+#elif V8_TARGET_ARCH_ARM64
+  BaselineAssembler::ScratchRegisterScope scratch_scope(&basm_);
+  Register address = scratch_scope.AcquireScratch();
+  Register depth = scratch_scope.AcquireScratch();
+  __ Move(address, ExternalReference::Create(
+                       IsolateAddressId::kReplayJsFrameDepthAddress,
+                       masm_.isolate()));
+  masm_.Ldr(depth.W(), MemOperand(address));
+  masm_.Sub(depth.W(), depth.W(), Immediate(1));
+  masm_.Str(depth.W(), MemOperand(address));
 #else
-  FATAL("ReplayDecJsFrameDepth Baseline lowering is x64 only");
+  FATAL("ReplayDecJsFrameDepth Baseline lowering is x64/arm64 only");
 #endif
 }
 
@@ -2347,11 +2395,37 @@ void BaselineCompiler::VisitRecordReplayNotifyActivity() {
   CallRuntime(Runtime::kRecordReplayNotifyActivity);
 }
 
+void BaselineCompiler::JumpIfRecordReplayInstrumentationDisabled(
+    Label* label) {
+  BaselineAssembler::ScratchRegisterScope scratch_scope(&basm_);
+  Register value = scratch_scope.AcquireScratch();
+  Label instrumented;
+  __ Move(value, ExternalReference::record_replay_instrumentation_enabled());
+  __ Move(value, MemOperand(value, 0));
+  __ JumpIfImmediate(Condition::kNotEqual, value, 0, &instrumented,
+                     Label::kNear);
+  __ Move(value, ExternalReference::record_replay_instrumented_functions());
+  __ Move(value, MemOperand(value, 0));
+  __ JumpIfImmediate(Condition::kEqual, value, 0, label);
+  __ LoadFunction(value);
+  __ LoadTaggedPointerField(value, value,
+                            JSFunction::kSharedFunctionInfoOffset);
+  __ LoadWord8Field(value, value, SharedFunctionInfo::kFlags2Offset);
+  __ TestAndBranch(value, SharedFunctionInfo::RecordReplayInstrumentedBit::kMask,
+                   Condition::kZero, label);
+  __ Bind(&instrumented);
+}
+
 void BaselineCompiler::VisitRecordReplayInstrumentation() {
-  SaveAccumulatorScope accumulator_scope(&basm_);
-  uint32_t index = Index(0);
-  CallRuntime(Runtime::kRecordReplayInstrumentation,
-              __ FunctionOperand(), Smi::FromInt(index));
+  Label done;
+  JumpIfRecordReplayInstrumentationDisabled(&done);
+  {
+    SaveAccumulatorScope accumulator_scope(&basm_);
+    uint32_t index = Index(0);
+    CallRuntime(Runtime::kRecordReplayInstrumentation,
+                __ FunctionOperand(), Smi::FromInt(index));
+  }
+  __ Bind(&done);
 }
 
 void BaselineCompiler::VisitRecordReplayInstrumentationGenerator() {
@@ -2362,10 +2436,15 @@ void BaselineCompiler::VisitRecordReplayInstrumentationGenerator() {
 }
 
 void BaselineCompiler::VisitRecordReplayInstrumentationReturn() {
-  SaveAccumulatorScope accumulator_scope(&basm_);
-  uint32_t index = Index(0);
-  CallRuntime(Runtime::kRecordReplayInstrumentationReturn,
-              __ FunctionOperand(), Smi::FromInt(index), RegisterOperand(1));
+  Label done;
+  JumpIfRecordReplayInstrumentationDisabled(&done);
+  {
+    SaveAccumulatorScope accumulator_scope(&basm_);
+    uint32_t index = Index(0);
+    CallRuntime(Runtime::kRecordReplayInstrumentationReturn,
+                __ FunctionOperand(), Smi::FromInt(index), RegisterOperand(1));
+  }
+  __ Bind(&done);
 }
 
 void BaselineCompiler::VisitRecordReplayAssertValue() {
@@ -132,6 +132,10 @@ class BaselineCompiler {
   void JumpIfToBoolean(bool do_jump_if_true, Label* label,
                        Label::Distance distance = Label::kFar);
 
+  // Jump to |label| if record/replay instrumentation callbacks are disabled
+  // for the current function.
+  void JumpIfRecordReplayInstrumentationDisabled(Label* label);
+
   // Call helpers.
   template <Builtin kBuiltin, typename... Args>
   void CallBuiltin(Args... args);
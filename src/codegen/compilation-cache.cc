@@ -285,8 +285,9 @@ InfoCellPair CompilationCache::LookupEval(Handle<String> source,
 
   // Evaluations aren't cached when recording/replaying because new sources
   // will not be generated on a cache hit, and sources need to be generated
-  // at deterministic points.
-  if (recordreplay::IsRecordingOrReplaying("no-eval-cache")) return result;
+  // at deterministic points. When this feature is disabled, hits are recorded
+  // by Compiler::GetFunctionFromEval instead.
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kNoEvalCache)) return result;
 
   const char* cache_type;
 
@@ -332,7 +333,7 @@ void CompilationCache::PutEval(Handle<String> source,
                                int position) {
   if (!IsEnabledScriptAndEval()) return;
 
-  if (recordreplay::IsRecordingOrReplaying("no-eval-cache")) return;
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kNoEvalCache)) return;
 
   const char* cache_type;
   HandleScope scope(isolate());
@@ -632,7 +632,7 @@ bool UseAsmWasm(FunctionLiteral* literal, bool asm_wasm_broken) {
 
   // Instrumentation added when recording/replaying requires that scripts be
   // compiled in the regular way.
-  if (recordreplay::IsRecordingOrReplaying("no-asm-wasm")) return false;
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kNoAsmWasm)) return false;
 
   // In stress mode we want to run the validator on everything.
   if (v8_flags.stress_validate_asm) return true;
@@ -2813,6 +2813,50 @@ MaybeHandle<SharedFunctionInfo> Compiler::CompileForLiveEdit(
                                        isolate, &is_compiled_scope);
 }
 
+// Get the top level function for an eval whose script was found in the eval
+// cache when recording. The script's existing function and bytecode are used
+// if they are still alive, otherwise the script is compiled again.
+static MaybeHandle<SharedFunctionInfo> RecordReplayCompileCachedEval(
+    Isolate* isolate, Handle<Script> script, Handle<Context> context,
+    LanguageMode language_mode, ParseRestriction restriction,
+    int parameters_end_pos, ParsingWhileDebugging parsing_while_debugging,
+    IsCompiledScope* is_compiled_scope) {
+  MaybeObject maybe_toplevel_sfi =
+      script->shared_function_infos().Get(kFunctionLiteralIdTopLevel);
+  if (maybe_toplevel_sfi.IsWeak()) {
+    Handle<SharedFunctionInfo> shared_info =
+        handle(SharedFunctionInfo::cast(
+                   maybe_toplevel_sfi.GetHeapObjectAssumeWeak()),
+               isolate);
+    *is_compiled_scope = shared_info->is_compiled_scope(isolate);
+    if (is_compiled_scope->is_compiled()) {
+      return shared_info;
+    }
+  }
+
+  UnoptimizedCompileFlags flags = UnoptimizedCompileFlags::ForToplevelCompile(
+      isolate, true, language_mode, REPLMode::kNo, ScriptType::kClassic,
+      v8_flags.lazy_eval, script->id());
+  flags.set_is_eval(true);
+  flags.set_parsing_while_debugging(parsing_while_debugging);
+  flags.set_parse_restriction(restriction);
+
+  SetRecordReplayFlags(flags, "");
+
+  UnoptimizedCompileState compile_state;
+  ReusableUnoptimizedCompileState reusable_state(isolate);
+  ParseInfo parse_info(isolate, flags, &compile_state, &reusable_state);
+  parse_info.set_parameters_end_pos(parameters_end_pos);
+
+  MaybeHandle<ScopeInfo> maybe_outer_scope_info;
+  if (!context->IsNativeContext()) {
+    maybe_outer_scope_info = handle(context->scope_info(), isolate);
+  }
+  return v8::internal::CompileToplevel(&parse_info, script,
+                                       maybe_outer_scope_info, isolate,
+                                       is_compiled_scope);
+}
+
 // static
 MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
     Handle<String> source, Handle<SharedFunctionInfo> outer_info,
@@ -2845,6 +2889,32 @@ MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
     feedback_cell = handle(eval_result.feedback_cell(), isolate);
   }
 
+  // As for scripts, the eval cache isn't used when replaying, and hits while
+  // recording must be recorded so that the same scripts are created at the
+  // same points. Replayed hits use the script created for the earlier eval.
+  MaybeHandle<Script> maybe_cached_script;
+  if (!recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kNoEvalCache) &&
+      recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kValues) &&
+      !recordreplay::AreEventsDisallowed() &&
+      IsMainThread() &&
+      !gReplaceSourceContentsScriptId) {
+    int script_id = v8::UnboundScript::kNoScriptId;
+    if (recordreplay::IsRecording() && eval_result.has_shared()) {
+      script_id = Script::cast(eval_result.shared().script()).id();
+
+      // Scripts which weren't registered can't be found when replaying.
+      if (MaybeGetScript(isolate, script_id).is_null()) {
+        eval_result = InfoCellPair();
+        feedback_cell = Handle<FeedbackCell>();
+        script_id = v8::UnboundScript::kNoScriptId;
+      }
+    }
+    script_id = (int)recordreplay::RecordReplayValue("GetFunctionFromEval script_id", script_id);
+    if (recordreplay::IsReplaying() && script_id != v8::UnboundScript::kNoScriptId) {
+      maybe_cached_script = GetScript(isolate, script_id);
+    }
+  }
+
   Handle<SharedFunctionInfo> shared_info;
   Handle<Script> script;
   IsCompiledScope is_compiled_scope;
@@ -2854,6 +2924,16 @@ MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
     script = Handle<Script>(Script::cast(shared_info->script()), isolate);
     is_compiled_scope = shared_info->is_compiled_scope(isolate);
     allow_eval_cache = true;
+  } else if (maybe_cached_script.ToHandle(&script)) {
+    if (!RecordReplayCompileCachedEval(isolate, script, context, language_mode,
+                                       restriction, parameters_end_pos,
+                                       parsing_while_debugging,
+                                       &is_compiled_scope)
+             .ToHandle(&shared_info)) {
+      return MaybeHandle<JSFunction>();
+    }
+    // The eval cache isn't used when replaying.
+    allow_eval_cache = false;
   } else {
     UnoptimizedCompileFlags flags = UnoptimizedCompileFlags::ForToplevelCompile(
         isolate, true, language_mode, REPLMode::kNo, ScriptType::kClassic,
@@ -3607,7 +3687,7 @@ MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
     // to record/replay whether a script was found when recording so that the
     // same scripts are created at the same points. The SFI will need to be
     // recompiled when replaying but that's fine when the right script ID is used.
-    if (recordreplay::IsRecordingOrReplaying("values") &&
+    if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kValues) &&
         !recordreplay::AreEventsDisallowed() &&
         IsMainThread() &&
         !gReplaceSourceContentsScriptId) {
@@ -3901,7 +3981,7 @@ Compiler::GetSharedFunctionInfoForStreamedScript(
   // For now we don't support using the compilation cache with streamed scripts,
   // due to the lack of support for handling the case when the script is present
   // but not the top level SFI.
-  if (!recordreplay::IsRecordingOrReplaying("no-streamed-script-cache")) {
+  if (!recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kNoStreamedScriptCache)) {
     TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
                  "V8.StreamingFinalization.CheckCache");
     CompilationCacheScript::LookupResult lookup_result =
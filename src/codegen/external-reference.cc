@@ -567,6 +567,10 @@ FUNCTION_REFERENCE(abort_with_reason, i::abort_with_reason)
 
 extern uint64_t* gProgressCounter;
 extern uint64_t gTargetProgress;
+extern bool gRecordReplayAssertProgress;
+extern intptr_t gRecordReplayCheckProgress;
+extern intptr_t gRecordReplayInstrumentationEnabled;
+extern intptr_t gRecordReplayInstrumentedFunctions;
 
 ExternalReference ExternalReference::record_replay_progress_counter() {
   return ExternalReference(gProgressCounter);
@@ -576,6 +580,22 @@ ExternalReference ExternalReference::record_replay_target_progress() {
   return ExternalReference(&gTargetProgress);
 }
 
+ExternalReference ExternalReference::record_replay_assert_progress() {
+  return ExternalReference(&gRecordReplayAssertProgress);
+}
+
+ExternalReference ExternalReference::record_replay_check_progress() {
+  return ExternalReference(&gRecordReplayCheckProgress);
+}
+
+ExternalReference ExternalReference::record_replay_instrumentation_enabled() {
+  return ExternalReference(&gRecordReplayInstrumentationEnabled);
+}
+
+ExternalReference ExternalReference::record_replay_instrumented_functions() {
+  return ExternalReference(&gRecordReplayInstrumentedFunctions);
+}
+
 ExternalReference ExternalReference::address_of_min_int() {
   return ExternalReference(reinterpret_cast<Address>(&double_min_int_constant));
 }
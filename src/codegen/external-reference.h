@@ -98,6 +98,12 @@ class StatsCounter;
   V(abort_with_reason, "abort_with_reason")                                    \
   V(record_replay_progress_counter, "record_replay_progress_counter")          \
   V(record_replay_target_progress, "record_replay_target_progress")            \
+  V(record_replay_assert_progress, "record_replay_assert_progress")            \
+  V(record_replay_check_progress, "record_replay_check_progress")              \
+  V(record_replay_instrumentation_enabled,                                     \
+    "record_replay_instrumentation_enabled")                                   \
+  V(record_replay_instrumented_functions,                                      \
+    "record_replay_instrumented_functions")                                    \
   V(address_of_log_or_trace_osr, "v8_flags.log_or_trace_osr")                  \
   V(address_of_FLAG_harmony_regexp_unicode_sets,                               \
     "v8_flags.harmony_regexp_unicode_sets")                                    \
@@ -34,7 +34,7 @@ namespace v8 {
 namespace internal {
 
 extern bool gRecordReplayAssertProgress;
-extern bool gRecordReplayInstrumentationEnabled;
+extern intptr_t gRecordReplayInstrumentationEnabled;
 
 namespace compiler {
 
@@ -3603,49 +3603,56 @@ void BytecodeGraphBuilder::VisitIncBlockCounter() {
 
 void BytecodeGraphBuilder::VisitRecordReplayIncExecutionProgressCounter() {
   PrepareEagerCheckpoint();
+  Node* closure = GetFunctionClosure();
+  const Operator* op =
+      javascript()->CallRuntime(Runtime::kRecordReplayAssertExecutionProgress);
 
-  // Use a VM call instead of an optimized path when we need to add assertions
-  // to the recording, or when replaying so that the calling code can be deoptimized
-  // when the target progress value has been reached.
-  if (gRecordReplayAssertProgress || recordreplay::IsReplaying()) {
-    Node* closure = GetFunctionClosure();
-    const Operator* op = javascript()->CallRuntime(Runtime::kRecordReplayAssertExecutionProgress);
-
+  // Use a VM call for every increment when we need to add assertions to the
+  // recording.
+  if (gRecordReplayAssertProgress) {
     Node* node = NewNode(op, closure);
     environment()->RecordAfterState(node, Environment::kAttachFrameState);
-  } else {
-    Node* node = NewNode(simplified()->IncrementAndCheckProgressCounter());
+    return;
+  }
+
+  // Otherwise the counter is incremented inline, and the VM is only called
+  // (without the counter having been incremented) when the target progress
+  // is about to be reached or progress checks are enabled. The VM call has a
+  // frame state so that the calling code can be deoptimized when the target
+  // progress has been reached while replaying.
+  Node* needs_runtime_call =
+      NewNode(simplified()->IncrementAndCheckProgressCounter());
+  NewBranch(needs_runtime_call, BranchHint::kFalse);
+  Environment* slow_environment;
+  {
+    SubEnvironment sub_environment(this);
+    NewIfTrue();
+    Node* node = NewNode(op, closure);
     environment()->RecordAfterState(node, Environment::kAttachFrameState);
+    slow_environment = environment();
   }
-  CHECK(needs_eager_checkpoint());
+  NewIfFalse();
+  NewMerge();
+  environment()->Merge(slow_environment,
+                       bytecode_analysis().GetOutLivenessFor(
+                           bytecode_iterator().current_offset()));
+  mark_as_needing_eager_checkpoint(true);
 }
 
 void BytecodeGraphBuilder::VisitReplayIncJsFrameDepth() {
   // SoftSO before TempSchedule so IfException attaches to ThrowCall.
-  // Simplified ops only — machine value ops are Typer UNREACHABLE.
-  FieldAccess depth_access(kUntaggedBase, 0, MaybeHandle<Name>(),
-                           MaybeHandle<Map>(), Type::Signed32(),
-                           MachineType::Int32(), kNoWriteBarrier,
-                           "ReplayJsFrameDepth");
-  Node* depth_addr = jsgraph()->ExternalConstant(ExternalReference::Create(
-      IsolateAddressId::kReplayJsFrameDepthAddress, isolate()));
-  Node* depth = NewNode(simplified()->LoadField(depth_access), depth_addr);
-  Node* incremented =
-      NewNode(simplified()->NumberAdd(), depth, jsgraph()->SmiConstant(1));
-  NewNode(simplified()->StoreField(depth_access), depth_addr, incremented);
-
-  Node* overflow = NewNode(
-      simplified()->NumberLessThanOrEqual(),
-      jsgraph()->SmiConstant(ThreadLocalTop::kReplayMaxJsFrameDepth),
-      incremented);
+  // The increment and limit check are a single node, lowered to machine
+  // operations in the EffectControlLinearizer.
+  Node* overflow =
+      NewNode(simplified()->ReplayIncrementAndCheckJsFrameDepth());
   NewBranch(overflow, BranchHint::kFalse);
   {
     SubEnvironment sub_environment(this);
     NewIfTrue();
     BuildLoopExitsForFunctionExit(bytecode_analysis().GetInLivenessFor(
         bytecode_iterator().current_offset()));
-    Node* throw_call =
-        NewNode(javascript()->CallRuntime(Runtime::kThrowStackOverflow));
+    Node* throw_call = NewNode(javascript()->CallRuntime(
+        Runtime::kRecordReplayThrowJsFrameDepthOverflow));
     environment()->RecordAfterState(throw_call, Environment::kAttachFrameState);
     Node* control = NewNode(common()->Throw());
     MergeControlToLeaveFunction(control);
@@ -3669,8 +3676,9 @@ void BytecodeGraphBuilder::VisitRecordReplayNotifyActivity() {
 void BytecodeGraphBuilder::VisitRecordReplayInstrumentation() {
   // If instrumentation is disabled then calls can be skipped entirely.
   // The optimized code will be discarded if instrumentation is enabled/disabled,
-  // see RecordReplayChangeInstrument.
-  if (!gRecordReplayInstrumentationEnabled) {
+  // see RecordReplayChangeInstrument and RecordReplayChangeFunctionInstrument.
+  if (!gRecordReplayInstrumentationEnabled &&
+      !shared_info().record_replay_instrumented()) {
     return;
   }
 
@@ -3701,7 +3709,8 @@ void BytecodeGraphBuilder::VisitRecordReplayInstrumentationGenerator() {
 
 void BytecodeGraphBuilder::VisitRecordReplayInstrumentationReturn() {
   // Disabled if instrumentation is disabled, as in VisitRecordReplayInstrumentation.
-  if (!gRecordReplayInstrumentationEnabled) {
+  if (!gRecordReplayInstrumentationEnabled &&
+      !shared_info().record_replay_instrumented()) {
     return;
   }
 
@@ -200,6 +200,7 @@ class EffectControlLinearizer {
   Node* LowerLoadFieldByIndex(Node* node);
   Node* LowerLoadMessage(Node* node);
   Node* LowerIncrementAndCheckProgressCounter(Node* node);
+  Node* LowerReplayIncrementAndCheckJsFrameDepth(Node* node);
   Node* LowerReplayDecrementJsFrameDepth(Node* node);
   Node* AdaptFastCallTypedArrayArgument(Node* node,
                                         ElementsKind expected_elements_kind,
@@ -1333,6 +1334,9 @@ bool EffectControlLinearizer::TryWireInStateEffect(Node* node,
     case IrOpcode::kIncrementAndCheckProgressCounter:
       result = LowerIncrementAndCheckProgressCounter(node);
       break;
+    case IrOpcode::kReplayIncrementAndCheckJsFrameDepth:
+      result = LowerReplayIncrementAndCheckJsFrameDepth(node);
+      break;
     case IrOpcode::kReplayDecrementJsFrameDepth:
       result = LowerReplayDecrementJsFrameDepth(node);
       break;
@@ -5020,38 +5024,47 @@ Node* EffectControlLinearizer::LowerLoadMessage(Node* node) {
 }
 
 Node* EffectControlLinearizer::LowerIncrementAndCheckProgressCounter(Node* node) {
-  auto reached_target_progress = __ MakeDeferredLabel();
-  auto done = __ MakeLabel();
+  // Produces whether the runtime needs to be called. In that case the counter
+  // is left alone, as Runtime_RecordReplayAssertExecutionProgress increments
+  // it itself.
+  auto done = __ MakeLabel(MachineRepresentation::kBit);
+
+  Node* check_progress =
+      __ ExternalConstant(ExternalReference::record_replay_check_progress());
+  Node* check_progress_value =
+      __ Load(MachineType::IntPtr(), check_progress, 0);
+  __ GotoIfNot(__ IntPtrEqual(check_progress_value, __ IntPtrConstant(0)),
+               &done, BranchHint::kTrue, __ Int32Constant(1));
 
   Node* progress_counter = __ ExternalConstant(ExternalReference::record_replay_progress_counter());
   Node* progress_counter_value = __ Load(MachineType::Uint64(), progress_counter, 0);
-  Node* incremented_value = __ IntAdd(progress_counter_value, __ Int32Constant(1));
-
-  __ Store(StoreRepresentation(MachineRepresentation::kWord64, kNoWriteBarrier),
-           progress_counter, 0, incremented_value);
+  Node* incremented_value = __ IntAdd(progress_counter_value, __ IntPtrConstant(1));
 
   Node* target_progress = __ ExternalConstant(ExternalReference::record_replay_target_progress());
   Node* target_progress_value = __ Load(MachineType::Uint64(), target_progress, 0);
-  Node* check = __ IntPtrEqual(incremented_value, target_progress_value);
+  __ GotoIf(__ IntPtrEqual(incremented_value, target_progress_value), &done,
+            BranchHint::kFalse, __ Int32Constant(1));
 
-  __ GotoIf(check, &reached_target_progress);
-  __ Goto(&done);
-
-  __ Bind(&reached_target_progress);
-
-  Operator::Properties properties = Operator::kNoDeopt | Operator::kNoThrow;
-  Runtime::FunctionId id = Runtime::kRecordReplayTargetProgressReached;
-  auto call_descriptor = Linkage::GetRuntimeCallDescriptor(
-    graph()->zone(), id, 0, properties, CallDescriptor::kNoFlags);
-  __ Call(call_descriptor, __ CEntryStubConstant(1),
-          __ ExternalConstant(ExternalReference::Create(id)),
-          __ Int32Constant(0), __ NoContextConstant());
+  __ Store(StoreRepresentation(MachineRepresentation::kWord64, kNoWriteBarrier),
+           progress_counter, 0, incremented_value);
+  __ Goto(&done, __ Int32Constant(0));
 
-  __ Goto(&done);
   __ Bind(&done);
+  return done.PhiAt(0);
+}
 
-  // It's not clear how to mark this node as not having any outputs...
-  return __ Int32Constant(0);
+Node* EffectControlLinearizer::LowerReplayIncrementAndCheckJsFrameDepth(
+    Node* node) {
+  // Produces whether the new depth has reached the limit, in which case the
+  // caller throws a stack overflow.
+  Node* depth_addr = __ ExternalConstant(ExternalReference::Create(
+      IsolateAddressId::kReplayJsFrameDepthAddress, isolate()));
+  Node* depth = __ Load(MachineType::Int32(), depth_addr, 0);
+  Node* incremented = __ Int32Add(depth, __ Int32Constant(1));
+  __ Store(StoreRepresentation(MachineRepresentation::kWord32, kNoWriteBarrier),
+           depth_addr, 0, incremented);
+  return __ Int32LessThanOrEqual(
+      __ Int32Constant(ThreadLocalTop::kReplayMaxJsFrameDepth), incremented);
 }
 
 Node* EffectControlLinearizer::LowerReplayDecrementJsFrameDepth(Node* node) {
@@ -902,6 +902,7 @@ class ScopeInfoRef : public HeapObjectRef {
   V(bool, is_compiled)                                     \
   V(bool, IsUserJavaScript)                                \
   V(bool, requires_instance_members_initializer)           \
+  V(bool, record_replay_instrumented)                      \
   IF_WASM(V, const wasm::WasmModule*, wasm_module)         \
   IF_WASM(V, const wasm::FunctionSig*, wasm_function_signature)
 
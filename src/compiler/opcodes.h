@@ -432,6 +432,7 @@
   V(FindOrderedHashMapEntry)            \
   V(FindOrderedHashMapEntryForInt32Key) \
   V(IncrementAndCheckProgressCounter)   \
+  V(ReplayIncrementAndCheckJsFrameDepth) \
   V(ReplayDecrementJsFrameDepth)              \
   V(FindOrderedHashSetEntry)            \
   V(InitializeImmutableInObject)        \
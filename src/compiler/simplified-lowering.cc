@@ -4033,6 +4033,8 @@ class RepresentationSelector {
         VisitInputs<T>(node);
         return SetOutput<T>(node, MachineRepresentation::kTagged);
       case IrOpcode::kIncrementAndCheckProgressCounter:
+      case IrOpcode::kReplayIncrementAndCheckJsFrameDepth:
+        return SetOutput<T>(node, MachineRepresentation::kBit);
       case IrOpcode::kReplayDecrementJsFrameDepth:
         return;
       case IrOpcode::kFrameState:
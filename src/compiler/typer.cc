@@ -1528,7 +1528,13 @@ Type Typer::Visitor::TypeJSObjectIsArray(Node* node) { return Type::Boolean(); }
 
 Type Typer::Visitor::TypeDateNow(Node* node) { return Type::Number(); }
 
-Type Typer::Visitor::TypeIncrementAndCheckProgressCounter(Node* node) { return Type::Any(); }
+Type Typer::Visitor::TypeIncrementAndCheckProgressCounter(Node* node) {
+  return Type::Boolean();
+}
+
+Type Typer::Visitor::TypeReplayIncrementAndCheckJsFrameDepth(Node* node) {
+  return Type::Boolean();
+}
 
 Type Typer::Visitor::TypeReplayDecrementJsFrameDepth(Node* node) {
   return Type::Any();
@@ -1644,6 +1644,13 @@ void Verifier::Visitor::Check(Node* node, const AllNodes& all) {
       CheckTypeIs(node, Type::Number());
       break;
     case IrOpcode::kIncrementAndCheckProgressCounter:
+      CHECK_EQ(0, value_count);
+      CheckTypeIs(node, Type::Boolean());
+      break;
+    case IrOpcode::kReplayIncrementAndCheckJsFrameDepth:
+      CHECK_EQ(0, value_count);
+      CheckTypeIs(node, Type::Boolean());
+      break;
     case IrOpcode::kReplayDecrementJsFrameDepth:
       CHECK_EQ(0, value_count);
       CheckTypeIs(node, Type::Any());
@@ -4,6 +4,7 @@
 
 #include "src/debug/debug.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -42,6 +43,7 @@
 #include "src/objects/js-generator-inl.h"
 #include "src/objects/js-promise-inl.h"
 #include "src/objects/slots.h"
+#include "src/replay/replay-isolate-data.h"
 #include "src/snapshot/embedded/embedded-data.h"
 
 #if V8_ENABLE_WEBASSEMBLY
@@ -2457,7 +2459,7 @@ void Debug::DoProcessCompileEvent(bool has_compile_error, Handle<Script> script)
 
 void Debug::ProcessCompileEvent(bool has_compile_error, Handle<Script> script) {
   Debug::DoProcessCompileEvent(has_compile_error, script);
-  if (!has_compile_error && recordreplay::IsRecordingOrReplaying("register-scripts") && IsMainThread()) {
+  if (!has_compile_error && recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kRegisterScripts) && IsMainThread()) {
     RecordReplayRegisterScript(script);
   }
 }
@@ -3185,43 +3187,9 @@ static void ForEachInstrumentationOp(Isolate* isolate, Handle<Script> script,
   }
 }
 
-// Information about breakpoints that have been sent to the record replay driver.
-struct BreakpointInfo {
-  std::string function_id_;
-  int bytecode_offset_;
-  BreakpointInfo(const std::string& function_id, int bytecode_offset)
-    : function_id_(function_id), bytecode_offset_(bytecode_offset) {}
-};
-typedef std::unordered_map<std::string, BreakpointInfo> BreakpointInfoMap;
-static BreakpointInfoMap* gBreakpoints;
-
-static std::string BreakpointKey(int script_id, int line, int column) {
-  std::ostringstream os;
-  os << script_id << ":" << line << ":" << column;
-  return os.str();
-}
-
-// Inverse of gBreakpoints mapping.
-struct BreakpointPosition {
-  int line_;
-  int column_;
-  BreakpointPosition(int line, int column)
-    : line_(line), column_(column) {}
-};
-typedef std::unordered_map<std::string, BreakpointPosition> BreakpointPositionMap;
-static BreakpointPositionMap* gBreakpointPositions;
-
-static std::string BreakpointPositionKey(std::string function_id,
-                                         int bytecode_offset) {
-  std::ostringstream os;
-  os << function_id << ":" << bytecode_offset;
-  return os.str();
-}
-
 extern const char* InstrumentationSiteKind(int index);
 extern int InstrumentationSiteSourcePosition(int index);
 extern int InstrumentationSiteFunctionIndex(int index);
-extern std::string GetRecordReplayFunctionId(Handle<SharedFunctionInfo> shared);
 
 static void GetInstrumentationSiteLocation(Handle<Script> script, int instrumentation_index,
                                            int* pline, int* pcolumn) {
@@ -3234,74 +3202,264 @@ static void GetInstrumentationSiteLocation(Handle<Script> script, int instrument
   *pcolumn = info.column;
 }
 
-static void ForEachInstrumentationOpInRange(
-  Isolate* isolate, Handle<Object> params,
-  const std::function<void(Handle<Script> script, int bytecode_offset,
-                           const std::string& function_id, int line, int column)> callback) {
-  int script_id = GetSourceIdProperty(isolate, params);
-  MaybeHandle<Script> maybe_script = MaybeGetScript(isolate, script_id);
+// An instrumentation site in a script, along with its source location.
+struct BreakpointSite {
+  // 1-indexed line and column, see GetInstrumentationSiteLocation.
+  int line_;
+  int column_;
+  // Start position of the function containing the site. Together with the
+  // script's ID this forms the site's function ID, see GetRecordReplayFunctionId.
+  int function_start_;
+  // Index of the site within its function, the "offset" in the protocol.
+  int function_index_;
+  // Whether this is a "breakpoint" site.
+  bool is_breakpoint_;
+};
 
-  if (maybe_script.is_null()) {
-    return;
+static bool BreakpointSiteLocationLess(const BreakpointSite& a,
+                                       const BreakpointSite& b) {
+  return std::tie(a.line_, a.column_) < std::tie(b.line_, b.column_);
+}
+
+static bool BreakpointSiteFunctionLess(const BreakpointSite& a,
+                                       const BreakpointSite& b) {
+  return std::tie(a.function_start_, a.function_index_) <
+         std::tie(b.function_start_, b.function_index_);
+}
+
+// Index of all instrumentation sites in a script, built once per script and
+// queried by binary search. Sites with equal keys are kept in the order they
+// were found, and lookups return the first of them.
+struct ScriptBreakpointIndex {
+  // Sorted by BreakpointSiteLocationLess.
+  std::vector<BreakpointSite> by_location_;
+  // Sorted by BreakpointSiteFunctionLess.
+  std::vector<BreakpointSite> by_function_;
+
+  const BreakpointSite* FindByLocation(int line, int column) const {
+    BreakpointSite key = { line, column, 0, 0, false };
+    auto iter = std::lower_bound(by_location_.begin(), by_location_.end(),
+                                 key, BreakpointSiteLocationLess);
+    if (iter == by_location_.end() || BreakpointSiteLocationLess(key, *iter)) {
+      return nullptr;
+    }
+    return &*iter;
   }
 
-  Handle<Script> script = maybe_script.ToHandleChecked();
+  const BreakpointSite* FindByFunction(int function_start,
+                                       int function_index) const {
+    BreakpointSite key = { 0, 0, function_start, function_index, false };
+    auto iter = std::lower_bound(by_function_.begin(), by_function_.end(),
+                                 key, BreakpointSiteFunctionLess);
+    if (iter == by_function_.end() || BreakpointSiteFunctionLess(key, *iter)) {
+      return nullptr;
+    }
+    return &*iter;
+  }
+};
 
-  int beginLine = 1, beginColumn = 0;
-  DecodeLocationProperty(isolate, params, "begin", &beginLine, &beginColumn);
+// Breakpoint indexes for each script which has been queried, keyed by script ID.
+typedef std::unordered_map<int, ScriptBreakpointIndex> ScriptBreakpointIndexMap;
+static ScriptBreakpointIndexMap* gBreakpointIndexes;
 
-  int endLine = INT32_MAX, endColumn = INT32_MAX;
-  DecodeLocationProperty(isolate, params, "end", &endLine, &endColumn);
+// Get the breakpoint index for a script, building it if necessary or if
+// |rebuild| is set.
+static const ScriptBreakpointIndex& GetBreakpointIndex(Isolate* isolate,
+                                                       Handle<Script> script,
+                                                       bool rebuild = false) {
+  if (!gBreakpointIndexes) {
+    gBreakpointIndexes = new ScriptBreakpointIndexMap();
+  }
+
+  auto iter = gBreakpointIndexes->find(script->id());
+  if (iter != gBreakpointIndexes->end() && !rebuild) {
+    return iter->second;
+  }
+
+  ScriptBreakpointIndex& index = (*gBreakpointIndexes)[script->id()];
+  index.by_location_.clear();
 
   ForEachInstrumentationOp(isolate, script, [&](Handle<SharedFunctionInfo> shared,
                                                 int instrumentation_index) {
-    if (strcmp(InstrumentationSiteKind(instrumentation_index), "breakpoint")) {
+    BreakpointSite site;
+    GetInstrumentationSiteLocation(script, instrumentation_index,
+                                   &site.line_, &site.column_);
+    site.function_start_ = shared->StartPosition();
+    site.function_index_ = InstrumentationSiteFunctionIndex(instrumentation_index);
+    site.is_breakpoint_ =
+        !strcmp(InstrumentationSiteKind(instrumentation_index), "breakpoint");
+    index.by_location_.push_back(site);
+  });
+
+  index.by_function_ = index.by_location_;
+  std::stable_sort(index.by_location_.begin(), index.by_location_.end(),
+                   BreakpointSiteLocationLess);
+  std::stable_sort(index.by_function_.begin(), index.by_function_.end(),
+                   BreakpointSiteFunctionLess);
+  return index;
+}
+
+extern intptr_t gRecordReplayInstrumentedFunctions;
+
+// Weak global handles to the functions whose instrumentation was enabled by
+// RecordReplayChangeFunctionInstrument. gRecordReplayInstrumentedFunctions is
+// kept equal to their number, so it drops again when such a function dies.
+static std::vector<Address*>* gInstrumentedFunctions;
+
+static void UpdateInstrumentedFunctionCount() {
+  gRecordReplayInstrumentedFunctions =
+      static_cast<intptr_t>(gInstrumentedFunctions->size());
+}
+
+static void RemoveInstrumentedFunctionHandle(
+    std::vector<Address*>::iterator it) {
+  GlobalHandles::Destroy(*it);
+  gInstrumentedFunctions->erase(it);
+  UpdateInstrumentedFunctionCount();
+}
+
+static void InstrumentedFunctionDied(const v8::WeakCallbackInfo<void>& data) {
+  Address* location = reinterpret_cast<Address*>(data.GetParameter());
+  auto it = std::find(gInstrumentedFunctions->begin(),
+                      gInstrumentedFunctions->end(), location);
+  CHECK(it != gInstrumentedFunctions->end());
+  RemoveInstrumentedFunctionHandle(it);
+}
+
+static void AddInstrumentedFunction(Isolate* isolate, SharedFunctionInfo info) {
+  if (!gInstrumentedFunctions) {
+    gInstrumentedFunctions = new std::vector<Address*>();
+  }
+  Address* location = isolate->global_handles()->Create(info).location();
+  GlobalHandles::MakeWeak(location, location, InstrumentedFunctionDied,
+                          v8::WeakCallbackType::kParameter);
+  gInstrumentedFunctions->push_back(location);
+  UpdateInstrumentedFunctionCount();
+}
+
+static void RemoveInstrumentedFunction(SharedFunctionInfo info) {
+  for (auto it = gInstrumentedFunctions->begin();
+       it != gInstrumentedFunctions->end(); ++it) {
+    if (*Handle<SharedFunctionInfo>(*it) == info) {
+      RemoveInstrumentedFunctionHandle(it);
       return;
     }
+  }
+  UNREACHABLE();
+}
 
-    int line, column;
-    GetInstrumentationSiteLocation(script, instrumentation_index, &line, &column);
+// Enable or disable instrumentation callbacks for the function in a script
+// starting at function_start, or every function in the script if
+// function_start is negative. This lets analyses which only need callbacks in
+// a few functions avoid RecordReplayChangeInstrument, which slows down every
+// function and discards all optimized code.
+void RecordReplayChangeFunctionInstrument(int script_id, int function_start,
+                                          bool enabled) {
+  CHECK(IsMainThread());
+  CHECK(!enabled || recordreplay::IsReplaying());
 
-    if (line < beginLine ||
-        (line == beginLine && column < beginColumn) ||
-        line > endLine ||
-        (line == endLine && column > endColumn)) {
-      return;
+  Isolate* isolate = Isolate::Current();
+  HandleScope scope(isolate);
+
+  Handle<Script> script;
+  if (!MaybeGetScript(isolate, script_id).ToHandle(&script)) {
+    recordreplay::Diagnostic("RecordReplayChangeFunctionInstrument unknown script %d",
+                             script_id);
+    return;
+  }
+
+  // Building the breakpoint index compiles every function in the script, so
+  // all the functions we might need to change have been created.
+  GetBreakpointIndex(isolate, script);
+
+  std::vector<Handle<SharedFunctionInfo>> changed;
+  SharedFunctionInfo::ScriptIterator iterator(isolate, *script);
+  for (SharedFunctionInfo info = iterator.Next(); !info.is_null();
+       info = iterator.Next()) {
+    if (function_start >= 0 && info.StartPosition() != function_start) continue;
+    if (info.record_replay_instrumented() == enabled) continue;
+    info.set_record_replay_instrumented(enabled);
+    if (enabled) {
+      AddInstrumentedFunction(isolate, info);
+    } else {
+      RemoveInstrumentedFunction(info);
     }
+    changed.push_back(handle(info, isolate));
+  }
 
-    int bytecode_offset = InstrumentationSiteFunctionIndex(instrumentation_index);
+  if (changed.empty()) {
+    return;
+  }
 
-    std::string function_id = GetRecordReplayFunctionId(shared);
-    callback(script, bytecode_offset, function_id, line, column);
-  });
+  // Optimized code omits instrumentation calls for uninstrumented functions,
+  // so discard any code which was compiled from the changed functions.
+  // Unoptimized code checks the function's flag when it runs.
+  isolate->AbortConcurrentOptimization(BlockingBehavior::kBlock);
+  bool found_something = false;
+  Code::OptimizedCodeIterator code_iterator(isolate);
+  for (Code code = code_iterator.Next(); !code.is_null();
+       code = code_iterator.Next()) {
+    for (const Handle<SharedFunctionInfo>& shared : changed) {
+      if (code.Inlines(*shared)) {
+        code.set_marked_for_deoptimization(true);
+        found_something = true;
+        break;
+      }
+    }
+  }
+  if (found_something) {
+    Deoptimizer::DeoptimizeMarkedCode(isolate);
+  }
 }
 
-static void GenerateBreakpointInfo(Isolate* isolate, Handle<Script> script) {
-  if (!gBreakpoints) {
-    gBreakpoints = new BreakpointInfoMap();
-  }
-  if (!gBreakpointPositions) {
-    gBreakpointPositions = new BreakpointPositionMap();
+// Format a function ID in the same way as GetRecordReplayFunctionId, without
+// allocating.
+static void FormatFunctionId(char (&buf)[32], int script_id, int function_start) {
+  snprintf(buf, sizeof(buf), "%d:%d", script_id, function_start);
+}
+
+static Handle<String> FunctionIdToHandle(Isolate* isolate, int script_id,
+                                         int function_start) {
+  char function_id[32];
+  FormatFunctionId(function_id, script_id, function_start);
+  return CStringToHandle(isolate, function_id);
+}
+
+// Call |callback| for each breakpoint site within the range given by |params|,
+// in order of their locations.
+static void ForEachBreakpointInRange(
+  Isolate* isolate, Handle<Object> params,
+  const std::function<void(Handle<Script> script,
+                           const BreakpointSite& site)> callback) {
+  int script_id = GetSourceIdProperty(isolate, params);
+  MaybeHandle<Script> maybe_script = MaybeGetScript(isolate, script_id);
+
+  if (maybe_script.is_null()) {
+    return;
   }
 
-  ForEachInstrumentationOp(isolate, script, [&](Handle<SharedFunctionInfo> shared,
-                                                int instrumentation_index) {
-    int line, column;
-    GetInstrumentationSiteLocation(script, instrumentation_index, &line, &column);
+  Handle<Script> script = maybe_script.ToHandleChecked();
 
-    std::string function_id = GetRecordReplayFunctionId(shared);
-    int bytecode_offset = InstrumentationSiteFunctionIndex(instrumentation_index);
+  int beginLine = 1, beginColumn = 0;
+  DecodeLocationProperty(isolate, params, "begin", &beginLine, &beginColumn);
 
-    std::string key = BreakpointKey(script->id(), line, column);
-    BreakpointInfo value(function_id, bytecode_offset);
-    gBreakpoints->insert(std::pair<std::string, BreakpointInfo>
-                         (key, value));
+  int endLine = INT32_MAX, endColumn = INT32_MAX;
+  DecodeLocationProperty(isolate, params, "end", &endLine, &endColumn);
 
-    std::string positionKey = BreakpointPositionKey(function_id, bytecode_offset);
-    BreakpointPosition position(line, column);
-    gBreakpointPositions->insert(std::pair<std::string, BreakpointPosition>
-                                 (positionKey, position));
-  });
+  const ScriptBreakpointIndex& index = GetBreakpointIndex(isolate, script);
+
+  BreakpointSite begin = { beginLine, beginColumn, 0, 0, false };
+  BreakpointSite end = { endLine, endColumn, 0, 0, false };
+  auto first = std::lower_bound(index.by_location_.begin(),
+                                index.by_location_.end(),
+                                begin, BreakpointSiteLocationLess);
+  auto last = std::upper_bound(first, index.by_location_.end(),
+                               end, BreakpointSiteLocationLess);
+  for (auto iter = first; iter != last; ++iter) {
+    if (iter->is_breakpoint_) {
+      callback(script, *iter);
+    }
+  }
 }
 
 static Handle<Object> RecordReplayGetPossibleBreakpoints(Isolate* isolate,
@@ -3309,16 +3467,15 @@ static Handle<Object> RecordReplayGetPossibleBreakpoints(Isolate* isolate,
   std::vector<std::vector<int>> lineColumns;
   int numLines = 0;
 
-  ForEachInstrumentationOpInRange(isolate, params,
-     [&](Handle<Script> script, int bytecode_offset,
-         const std::string& function_id, int line, int column) {
-    while ((size_t)line >= lineColumns.size()) {
+  ForEachBreakpointInRange(isolate, params,
+     [&](Handle<Script> script, const BreakpointSite& site) {
+    while ((size_t)site.line_ >= lineColumns.size()) {
       lineColumns.emplace_back();
     }
-    if (!lineColumns[line].size()) {
+    if (!lineColumns[site.line_].size()) {
       numLines++;
     }
-    lineColumns[line].push_back(column);
+    lineColumns[site.line_].push_back(site.column_);
   });
 
   Handle<FixedArray> lineLocations = isolate->factory()->NewFixedArray(numLines);
@@ -3439,20 +3596,16 @@ void RecordReplayGetPossibleBreakpointsCallback(const char* script_id_str) {
 
   Handle<Script> script = maybe_script.ToHandleChecked();
 
-  ForEachInstrumentationOp(isolate, script, [&](Handle<SharedFunctionInfo> shared,
-                                                int instrumentation_index) {
-    if (strcmp(InstrumentationSiteKind(instrumentation_index), "breakpoint")) {
-      return;
+  const ScriptBreakpointIndex& index = GetBreakpointIndex(isolate, script);
+  for (const BreakpointSite& site : index.by_location_) {
+    if (!site.is_breakpoint_) {
+      continue;
     }
-
-    int line, column;
-    GetInstrumentationSiteLocation(script, instrumentation_index, &line, &column);
-
-    int function_index = InstrumentationSiteFunctionIndex(instrumentation_index);
-
-    std::string function_id = GetRecordReplayFunctionId(shared);
-    RecordReplayAddPossibleBreakpoint(line, column, function_id.c_str(), function_index);
-  });
+    char function_id[32];
+    FormatFunctionId(function_id, script->id(), site.function_start_);
+    RecordReplayAddPossibleBreakpoint(site.line_, site.column_, function_id,
+                                      site.function_index_);
+  }
 }
 
 Handle<Object> RecordReplayConvertLocationToFunctionOffset(Isolate* isolate,
@@ -3462,25 +3615,21 @@ Handle<Object> RecordReplayConvertLocationToFunctionOffset(Isolate* isolate,
   int line = GetProperty(isolate, location, "line")->Number();
   int column = GetProperty(isolate, location, "column")->Number();
 
-  std::string key = BreakpointKey(sourceId, line, column);
-  if (!gBreakpoints) {
-    Handle<Script> script = GetScript(isolate, sourceId);
-    GenerateBreakpointInfo(isolate, script);
-  }
-  auto iter = gBreakpoints->find(key);
-  if (iter == gBreakpoints->end()) {
-    Handle<Script> script = GetScript(isolate, sourceId);
-    GenerateBreakpointInfo(isolate, script);
-
-    iter = gBreakpoints->find(key);
-    if (iter == gBreakpoints->end()) {
+  Handle<Script> script = GetScript(isolate, sourceId);
+  const BreakpointSite* site =
+      GetBreakpointIndex(isolate, script).FindByLocation(line, column);
+  if (!site) {
+    site = GetBreakpointIndex(isolate, script, /* rebuild */ true)
+               .FindByLocation(line, column);
+    if (!site) {
       return NewPlainObject(isolate);
     }
   }
 
   Handle<JSObject> rv = NewPlainObject(isolate);
-  SetProperty(isolate, rv, "functionId", iter->second.function_id_.c_str());
-  SetProperty(isolate, rv, "offset", iter->second.bytecode_offset_);
+  SetProperty(isolate, rv, "functionId",
+              FunctionIdToHandle(isolate, sourceId, site->function_start_));
+  SetProperty(isolate, rv, "offset", site->function_index_);
   return rv;
 }
 
@@ -3505,19 +3654,16 @@ static Handle<Object> RecordReplayConvertFunctionOffsetToLocation(
   if (offset_raw->IsNumber()) {
     int bytecode_offset = offset_raw->Number();
 
-    std::string key = BreakpointPositionKey(function_id, bytecode_offset);
-    if (!gBreakpointPositions) {
-      GenerateBreakpointInfo(isolate, script);
-    }
-    auto iter = gBreakpointPositions->find(key);
-    if (iter == gBreakpointPositions->end()) {
-      GenerateBreakpointInfo(isolate, script);
-      iter = gBreakpointPositions->find(key);
+    const BreakpointSite* site = GetBreakpointIndex(isolate, script)
+        .FindByFunction(function_source_position, bytecode_offset);
+    if (!site) {
+      site = GetBreakpointIndex(isolate, script, /* rebuild */ true)
+          .FindByFunction(function_source_position, bytecode_offset);
     }
 
-    if (iter != gBreakpointPositions->end()) {
-      line = iter->second.line_;
-      column = iter->second.column_;
+    if (site) {
+      line = site->line_;
+      column = site->column_;
     } else {
       recordreplay::Diagnostic("Unknown offset %s %d for RecordReplayConvertFunctionOffsetToLocation",
                                 function_id.c_str(), bytecode_offset);
@@ -3554,34 +3700,36 @@ static Handle<Object> RecordReplayCountStackFrames(Isolate* isolate,
   // This is handled in C++ instead of via a protocol JS handler for efficiency.
   // Counting the stack frames is a common operation when there are many
   // exception unwinds and so forth.
+  //
+  // Only the functions in each frame are needed, including inlined functions
+  // in optimized frames, so frames are not summarized and nothing is
+  // allocated on the heap.
   size_t count = 0;
-  for (StackFrameIterator it(isolate); !it.done(); it.Advance()) {
-    StackFrame* frame = it.frame();
-    if (!frame->is_java_script()) {
-      continue;
-    }
-    std::vector<FrameSummary> frames;
-    CommonFrame::cast(frame)->Summarize(&frames);
-
-    // We don't strictly need to iterate the frames in reverse order, but it
-    // helps when logging the stack contents for debugging.
-    for (int i = (int)frames.size() - 1; i >= 0; i--) {
-      const auto& summary = frames[i];
-      CHECK(summary.IsJavaScript());
-      const auto& js = summary.AsJavaScript();
-
-      Handle<SharedFunctionInfo> shared(js.function()->shared(), isolate);
-
-      // See GetStackLocation.
-      if (!shared->StartPosition() && !shared->EndPosition()) {
+  {
+    DisallowGarbageCollection no_gc;
+    std::vector<SharedFunctionInfo>& functions =
+        isolate->EnsureReplayData()->stack_locations().functions;
+    for (StackFrameIterator it(isolate); !it.done(); it.Advance()) {
+      StackFrame* frame = it.frame();
+      if (!frame->is_java_script()) {
         continue;
       }
+      functions.clear();
+      JavaScriptFrame::cast(frame)->GetFunctions(&functions);
 
-      Handle<Script> script(Script::cast(shared->script()), isolate);
-      if (script->id() && RecordReplayHasRegisteredScript(*script)) {
-        count++;
+      for (SharedFunctionInfo shared : functions) {
+        // See GetStackLocation.
+        if (!shared.StartPosition() && !shared.EndPosition()) {
+          continue;
+        }
+
+        Script script = Script::cast(shared.script());
+        if (script.id() && RecordReplayHasRegisteredScript(script)) {
+          count++;
+        }
       }
     }
+    functions.clear();
   }
 
   Handle<JSObject> rv = NewPlainObject(isolate);
@@ -3591,21 +3739,23 @@ static Handle<Object> RecordReplayCountStackFrames(Isolate* isolate,
 
 static Handle<Object> RecordReplayGetFunctionsInRange(Isolate* isolate,
                                                       Handle<Object> params) {
-  std::set<std::string> functions;
-  ForEachInstrumentationOpInRange(isolate, params,
-     [&](Handle<Script> script, int bytecode_offset,
-         const std::string& function_id, int line, int column) {
-    functions.insert(function_id);
+  int script_id = 0;
+  std::set<int> function_starts;
+  ForEachBreakpointInRange(isolate, params,
+     [&](Handle<Script> script, const BreakpointSite& site) {
+    script_id = script->id();
+    function_starts.insert(site.function_start_);
   });
 
-  Handle<FixedArray> functionsArray = isolate->factory()->NewFixedArray((int)functions.size());
+  Handle<FixedArray> functionsArray =
+      isolate->factory()->NewFixedArray((int)function_starts.size());
 
   int index = 0;
-  for (const std::string& function_id : functions) {
-    Handle<String> str = CStringToHandle(isolate, function_id.c_str());
+  for (int function_start : function_starts) {
+    Handle<String> str = FunctionIdToHandle(isolate, script_id, function_start);
     functionsArray->set(index++, *str);
   }
-  CHECK(index == (int)functions.size());
+  CHECK(index == (int)function_starts.size());
 
   Handle<JSArray> functionsJSArray =
     isolate->factory()->NewJSArrayWithElements(functionsArray);
@@ -3707,7 +3857,7 @@ static base::Mutex* gOpcodeEmitByScriptMutex = new base::Mutex;
 // decision per script_id (both lit and dark).
 bool RecordReplayShouldEmitOpcodes(int script_id, bool record_replay_ignore) {
   const bool base_emit_opcodes =
-      recordreplay::IsRecordingOrReplaying("emit-opcodes") &&
+      recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kEmitOpcodes) &&
       RecordReplayHasDefaultContext() && !record_replay_ignore;
   if (script_id == v8::UnboundScript::kNoScriptId) return base_emit_opcodes;
   base::MutexGuard guard(gOpcodeEmitByScriptMutex);
@@ -3880,7 +4030,7 @@ extern "C" void V8RecordReplayGetDefaultContext(v8::Isolate* isolate, v8::Local<
 std::string RecordReplayContextAddressToken(v8::Isolate* isolate,
                                             uintptr_t ctxAddr, bool includeId);
 extern uint64_t* gProgressCounter;
-extern int gRecordReplayCheckProgress;
+extern intptr_t gRecordReplayCheckProgress;
 int gPauseContextGroupId = 0;
 
 // Make sure that the isolate has a context by switching to the default
@@ -4064,34 +4214,36 @@ static std::string StringPrintf(const char* format, ...) {
 
 // When assertions are used we assign an ID to each object that is ever
 // encountered in one, so that we can determine whether consistent objects
-// are used when replaying.
-struct ContextObjectIdMap {
-  v8::Global<v8::Context> context_;
-  v8::Global<v8::Value> object_ids_;
-};
-typedef std::vector<ContextObjectIdMap> ContextObjectIdMapVector;
-static ContextObjectIdMapVector* gRecordReplayObjectIds;
-
-static Local<v8::Value> GetObjectIdMapForContext(v8::Isolate* v8_isolate, Local<v8::Context> cx) {
-  Isolate* isolate = (Isolate*)v8_isolate;
-
-  if (!gRecordReplayObjectIds) {
-    gRecordReplayObjectIds = new ContextObjectIdMapVector();
+// are used when replaying. IDs for objects in all contexts are stored in a
+// single ephemeron table owned by the isolate's replay data, which is keyed by
+// the objects' identity hashes and so stays consistent across GCs.
+// The table is only created when an ID is first assigned, so that merely
+// looking up IDs doesn't allocate.
+static MaybeHandle<EphemeronHashTable> GetObjectIdMap(Isolate* isolate,
+                                                      bool allow_create) {
+  Address*& object_ids = isolate->EnsureReplayData()->object_ids();
+  if (object_ids) {
+    return Handle<EphemeronHashTable>(object_ids);
   }
-
-  for (const auto& entry : *gRecordReplayObjectIds) {
-    if (entry.context_ == cx) {
-      return entry.object_ids_.Get(v8_isolate);
-    }
+  if (!allow_create) {
+    return MaybeHandle<EphemeronHashTable>();
   }
+  Handle<EphemeronHashTable> table = EphemeronHashTable::New(isolate, 1);
+  object_ids = isolate->global_handles()->Create(*table).location();
+  return Handle<EphemeronHashTable>(object_ids);
+}
 
-  Handle<Object> object_ids = isolate->factory()->NewJSWeakMap();
-
-  ContextObjectIdMap new_entry;
-  new_entry.context_.Reset(v8_isolate, cx);
-  new_entry.object_ids_.Reset(v8_isolate, v8::Utils::ToLocal(object_ids));
-  gRecordReplayObjectIds->push_back(std::move(new_entry));
-  return gRecordReplayObjectIds->back().object_ids_.Get(v8_isolate);
+static void SetObjectId(Isolate* isolate, Handle<EphemeronHashTable> object_ids,
+                        Handle<Object> object, int id, int32_t hash) {
+  Handle<EphemeronHashTable> table(*object_ids, isolate);
+  Handle<EphemeronHashTable> new_table = EphemeronHashTable::Put(
+      isolate, table, object, handle(Smi::FromInt(id), isolate), hash);
+  if (*table != *new_table) {
+    // Update the global handle and zap the old table, as JSWeakCollection::Set
+    // does, since we didn't record slots for its elements.
+    object_ids.PatchValue(*new_table);
+    EphemeronHashTable::FillEntriesWithHoles(table);
+  }
 }
 
 extern bool gRecordReplayAssertTrackedObjects;
@@ -4119,25 +4271,18 @@ int RecordReplayObjectId(v8::Isolate* v8_isolate, v8::Local<v8::Context> cx,
   Isolate* isolate = (Isolate*)v8_isolate;
   Handle<Object> object = Utils::OpenHandle(*v8_object);
 
-  // Look through all weak maps we've created, the object might not be associated
-  // with the current context.
-  if (gRecordReplayObjectIds) {
-    for (const auto& entry : *gRecordReplayObjectIds) {
-      Local<v8::Value> object_ids_val = entry.object_ids_.Get(v8_isolate);
-      Handle<JSWeakMap> object_ids = Handle<JSWeakMap>::cast(Utils::OpenHandle(*object_ids_val));
-
-      Handle<Object> existing(EphemeronHashTable::cast(object_ids->table()).Lookup(object), isolate);
-      if (!existing->IsTheHole(isolate)) {
-        v8::Local<v8::Value> id_value = v8::Utils::ToLocal(existing);
-        if (id_value->IsInt32()) {
-          int id = id_value.As<v8::Int32>()->Value();
-          if (gRecordReplayAssertTrackedObjects) {
-            recordreplay::AssertMaybeEventsDisallowed("JS ReuseObjectId %d", id);
-          }
-          return id;
-        }
-      }
+  Handle<EphemeronHashTable> object_ids;
+  if (!GetObjectIdMap(isolate, allow_create).ToHandle(&object_ids)) {
+    return 0;
+  }
+
+  Object existing = object_ids->Lookup(object);
+  if (existing.IsSmi()) {
+    int id = Smi::ToInt(existing);
+    if (gRecordReplayAssertTrackedObjects) {
+      recordreplay::AssertMaybeEventsDisallowed("JS ReuseObjectId %d", id);
     }
+    return id;
   }
 
   if (!allow_create) {
@@ -4150,13 +4295,8 @@ int RecordReplayObjectId(v8::Isolate* v8_isolate, v8::Local<v8::Context> cx,
     recordreplay::AssertMaybeEventsDisallowed("JS NewObjectId %d", id);
   }
 
-  Local<Value> id_value = v8::Integer::New(v8_isolate, id);
-
   int32_t hash = object->GetOrCreateHash(isolate).value();
-
-  Local<v8::Value> object_ids_val = GetObjectIdMapForContext(v8_isolate, cx);
-  Handle<JSWeakMap> object_ids = Handle<JSWeakMap>::cast(Utils::OpenHandle(*object_ids_val));
-  JSWeakCollection::Set(object_ids, object, Utils::OpenHandle(*id_value), hash);
+  SetObjectId(isolate, object_ids, object, id, hash);
 
   return id;
 }
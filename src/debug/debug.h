@@ -18,6 +18,7 @@
 #include "src/handles/handles.h"
 #include "src/objects/debug-objects.h"
 #include "src/objects/shared-function-info.h"
+#include "src/replay/progress-data-buffer.h"
 
 namespace v8 {
 namespace internal {
@@ -733,8 +734,9 @@ class RecordReplayScrubDivergentProgressScope {
 
  private:
   bool active_;
+  bool has_data_mark_;
   uint64_t start_progress_;
-  size_t start_data_size_;
+  RecordReplayProgressDataMark start_data_mark_;
 };
 
 }  // namespace internal
@@ -1697,15 +1697,19 @@ void Isolate::RequestInterrupt(InterruptCallback callback, void* data) {
 extern void RecordReplayTriggerProgressInterrupt();
 
 void Isolate::InvokeApiInterruptCallbacks() {
-  if (recordreplay::IsRecordingOrReplaying("interrupts")) {
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kInterrupts)) {
     // When recording, we can't invoke API interrupt callbacks at arbitrary points
     // where we check for interrupts, as we won't be able to invoke those callbacks
     // at the same point when replaying. Instead, after detecting that interrupts
     // have been added to the queue we trigger an interrupt the next time the progress
     // counter advances, and will invoke the callbacks then.
-    if (recordreplay::IsRecording() && IsMainThread()) {
+    // The progress interrupt is only triggered once for all the callbacks
+    // queued before it is delivered.
+    if (recordreplay::IsRecording() && IsMainThread() &&
+        !record_replay_api_interrupts_triggered_) {
       ExecutionAccess access(this);
       if (!api_interrupts_queue_.empty()) {
+        record_replay_api_interrupts_triggered_ = true;
         RecordReplayTriggerProgressInterrupt();
       }
     }
@@ -1729,25 +1733,31 @@ void Isolate::InvokeApiInterruptCallbacks() {
 }
 
 void Isolate::RecordReplayInvokeApiInterruptCallbacksAtProgress() {
-  CHECK(recordreplay::IsRecordingOrReplaying("interrupts"));
+  CHECK(recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kInterrupts));
   CHECK(IsMainThread());
 
+  record_replay_api_interrupts_triggered_ = false;
+
+  // All callbacks queued so far are taken with a single acquisition of the
+  // ordered lock. Callbacks queued while these run are handled afterwards.
+  std::queue<InterruptEntry> entries;
   while (true) {
-    InterruptEntry entry;
     recordreplay::OrderedLock(record_replay_api_interrupts_ordered_lock_id_);
     {
       ExecutionAccess access(this);
-      if (api_interrupts_queue_.empty()) {
-        recordreplay::OrderedUnlock(record_replay_api_interrupts_ordered_lock_id_);
-        return;
-      }
-      entry = api_interrupts_queue_.front();
-      api_interrupts_queue_.pop();
+      std::swap(entries, api_interrupts_queue_);
     }
     recordreplay::OrderedUnlock(record_replay_api_interrupts_ordered_lock_id_);
+    if (entries.empty()) {
+      return;
+    }
     VMState<EXTERNAL> state(this);
-    HandleScope handle_scope(this);
-    entry.first(reinterpret_cast<v8::Isolate*>(this), entry.second);
+    while (!entries.empty()) {
+      InterruptEntry entry = entries.front();
+      entries.pop();
+      HandleScope handle_scope(this);
+      entry.first(reinterpret_cast<v8::Isolate*>(this), entry.second);
+    }
   }
 }
 
@@ -1971,7 +1981,7 @@ class SetThreadInWasmFlagScope {
 }  // namespace
 
 static void ReplaySyncJsFrameDepth(Isolate* isolate) {
-  if (!recordreplay::IsRecordingOrReplaying("emit-opcodes")) return;
+  if (!recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kEmitOpcodes)) return;
 
   HandleScope scope(isolate);
   int skip = static_cast<int>(
@@ -3913,6 +3923,9 @@ Isolate::~Isolate() {
 
   bigint_processor_->Destroy();
 
+  // Replay data holds global handles.
+  replay_data_.reset();
+
   delete global_handles_;
   global_handles_ = nullptr;
   delete eternal_handles_;
@@ -5616,7 +5629,7 @@ void Isolate::CountUsage(v8::Isolate::UseCounterFeature feature) {
   // Don't count usage when recording/replaying, as this can involve posting
   // tasks to other threads in places that run non-deterministically
   // (e.g. compilation).
-  if (recordreplay::IsRecordingOrReplaying("no-count-usage")) {
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kNoCountUsage)) {
     return;
   }
 
@@ -2381,6 +2381,10 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   // vs. the isolate's thread removing and running them.
   int record_replay_api_interrupts_ordered_lock_id_ = 0;
 
+  // Whether a progress interrupt has been triggered for queued API interrupts
+  // and not yet delivered. Only used on the main thread when recording.
+  bool record_replay_api_interrupts_triggered_ = false;
+
   std::unique_ptr<replayio::ReplayIsolateData> replay_data_;
 
 #define GLOBAL_BACKING_STORE(type, name, initialvalue) type name##_;
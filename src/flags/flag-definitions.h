@@ -1309,6 +1309,17 @@ DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_BOOL(incremental_marking_wrappers, true,
             "use incremental marking for marking wrappers")
 DEFINE_BOOL(incremental_marking_task, true, "use tasks for incremental marking")
+DEFINE_BOOL(deterministic_incremental_marking, false,
+            "only start and advance incremental marking based on allocation "
+            "and execution progress, never based on time, idle notifications "
+            "or tasks")
+DEFINE_IMPLICATION(deterministic_incremental_marking, incremental_marking)
+DEFINE_NEG_IMPLICATION(deterministic_incremental_marking,
+                       incremental_marking_task)
+DEFINE_NEG_IMPLICATION(deterministic_incremental_marking, concurrent_marking)
+DEFINE_NEG_IMPLICATION(deterministic_incremental_marking, parallel_marking)
+DEFINE_NEG_IMPLICATION(deterministic_incremental_marking,
+                       cppheap_concurrent_marking)
 DEFINE_INT(incremental_marking_soft_trigger, 0,
            "threshold for starting incremental marking via a task in percent "
            "of available space: limit - size")
@@ -1317,6 +1328,14 @@ DEFINE_INT(incremental_marking_hard_trigger, 0,
            "threshold for starting incremental marking immediately in percent "
            "of available space: limit - size")
 DEFINE_BOOL(trace_unmapper, false, "Trace the unmapping")
+DEFINE_BOOL(numa_aware_page_allocation, false,
+            "place heap pages on the NUMA node of the allocating thread and "
+            "prefer local pages when reusing pooled pages and in parallel "
+            "sweeping, scavenging, young generation marking and evacuation")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "align the code range and old space pages to huge pages and ask "
+            "the OS to back them with transparent huge pages (in the code "
+            "range this only benefits the remapped embedded builtins)")
 DEFINE_INT(minor_mc_task_trigger, 80,
            "minormc task trigger in percent of the current heap limit")
 DEFINE_BOOL(parallel_scavenge, true, "parallel scavenge")
@@ -1326,6 +1345,8 @@ DEFINE_INT(scavenge_task_trigger, 80,
 DEFINE_BOOL(scavenge_separate_stack_scanning, false,
             "use a separate phase for stack scanning in scavenge")
 DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenge")
+DEFINE_INT(scavenger_max_task_num, 0,
+           "max number of parallel scavenge tasks, 0 for no additional limit")
 DEFINE_BOOL(cppgc_young_generation, false,
             "run young generation garbage collections in Oilpan")
 DEFINE_BOOL(write_protect_code_memory, true, "write protect code memory")
@@ -1350,6 +1371,8 @@ DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "ephemeron algorithm")
 DEFINE_BOOL(trace_concurrent_marking, false, "trace concurrent marking")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_INT(concurrent_sweeping_max_worker_num, 0,
+           "max number of concurrent sweeper tasks, 0 for no additional limit")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
@@ -1753,6 +1776,8 @@ DEFINE_INT(heap_snapshot_string_limit, 1024,
            "truncate strings to this length in the heap snapshot")
 DEFINE_BOOL(heap_profiler_show_hidden_objects, false,
             "use 'native' rather than 'hidden' node type in snapshot")
+DEFINE_BOOL(parallel_heap_snapshot, true,
+            "use parallel threads to extract heap snapshot references")
 #ifdef V8_ENABLE_HEAP_SNAPSHOT_VERIFY
 DEFINE_BOOL(heap_snapshot_verify, false,
             "verify that heap snapshot matches marking visitor behavior")
@@ -118,10 +118,16 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
   //    the 4Gb boundary,
   //  - rounding up the adjusted size would result in requresting unnecessarily
   //    big aligment.
-  const size_t base_alignment =
+  size_t base_alignment =
       V8_EXTERNAL_CODE_SPACE_BOOL
           ? base::bits::RoundUpToPowerOfTwo(requested)
           : VirtualMemoryCage::ReservationParams::kAnyBaseAlignment;
+  const size_t huge_page_size =
+      v8_flags.transparent_huge_pages ? base::OS::HugePageSize() : 0;
+  if (huge_page_size > 0) {
+    // Huge pages can only back huge page aligned parts of the range.
+    base_alignment = std::max(base_alignment, huge_page_size);
+  }
 
   const size_t reserved_area = GetWritableReservedAreaSize();
   if (requested < (kMaximalCodeRangeSize - reserved_area)) {
@@ -175,6 +181,15 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
         base, size, PageAllocator::kReadWriteExecute));
     CHECK(params.page_allocator->DiscardSystemPages(base, size));
   }
+  if (huge_page_size > 0) {
+    // In practice this only benefits the remapped embedded builtins, which
+    // are one contiguous read-execute mapping. Code pages are committed one
+    // at a time with guard pages and their own permissions, which keeps the
+    // kernel from collapsing them into huge pages.
+    huge_pages_advised_ = base::OS::AdviseHugePages(
+        reinterpret_cast<void*>(page_allocator_->begin()),
+        page_allocator_->size());
+  }
   return true;
 }
 
@@ -220,6 +235,11 @@ uint8_t* CodeRange::RemapEmbeddedBuiltins(Isolate* isolate,
   size_t hint_offset =
       std::min(max_pc_relative_code_range, code_region.size()) -
       allocate_code_size;
+  if (huge_pages_advised_) {
+    // Start the copy on a huge page so that it is covered by as few huge
+    // pages as possible.
+    hint_offset = RoundDown(hint_offset, base::OS::HugePageSize());
+  }
   void* hint = reinterpret_cast<void*>(code_region.begin() + hint_offset);
 
   embedded_blob_code_copy =
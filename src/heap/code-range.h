@@ -114,6 +114,10 @@ class CodeRange final : public VirtualMemoryCage {
 
   bool InitReservation(v8::PageAllocator* page_allocator, size_t requested);
 
+  // Whether the OS was asked to back the code range with transparent huge
+  // pages, see --transparent-huge-pages.
+  bool huge_pages_advised() const { return huge_pages_advised_; }
+
   void Free();
 
   // Remap and copy the embedded builtins into this CodeRange. This method is
@@ -145,6 +149,8 @@ class CodeRange final : public VirtualMemoryCage {
   // race during Isolate::Init.
   base::Mutex remap_embedded_builtins_mutex_;
 
+  bool huge_pages_advised_ = false;
+
 #ifdef V8_OS_WIN64
   std::atomic<uint32_t> unwindinfo_use_count_{0};
 #endif
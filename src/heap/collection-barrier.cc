@@ -77,7 +77,24 @@ void CollectionBarrier::CancelCollectionAndResumeThreads() {
   cv_wakeup_.NotifyAll();
 }
 
+void CollectionBarrier::SetMainThreadBlocked(bool blocked) {
+  main_thread_blocked_.store(blocked);
+  if (!blocked) return;
+
+  // Threads waiting for the GC have requested it before checking this flag,
+  // so if no GC is requested any later waiter will see the flag. This keeps
+  // the mutex off the main thread's path in the common case.
+  if (!collection_requested_.load()) return;
+  base::MutexGuard guard(&mutex_);
+  cv_wakeup_.NotifyAll();
+}
+
 bool CollectionBarrier::AwaitCollectionBackground(LocalHeap* local_heap) {
+  return AwaitCollectionBackground(local_heap, base::TimeDelta::Max());
+}
+
+bool CollectionBarrier::AwaitCollectionBackground(LocalHeap* local_heap,
+                                                  base::TimeDelta timeout) {
   bool first_thread;
 
   {
@@ -100,9 +117,23 @@ bool CollectionBarrier::AwaitCollectionBackground(LocalHeap* local_heap) {
   ParkedScope scope(local_heap);
   base::MutexGuard guard(&mutex_);
 
+  base::TimeTicks deadline;
+  if (!timeout.IsMax()) deadline = base::TimeTicks::Now() + timeout;
+
   while (block_for_collection_) {
     if (shutdown_requested_) return false;
-    cv_wakeup_.Wait(&mutex_);
+    // The main thread can't perform the GC until it is unblocked. The GC
+    // stays requested.
+    if (main_thread_blocked_.load()) return false;
+    if (timeout.IsMax()) {
+      cv_wakeup_.Wait(&mutex_);
+    } else {
+      base::TimeDelta remaining = deadline - base::TimeTicks::Now();
+      if (remaining <= base::TimeDelta() ||
+          (!cv_wakeup_.WaitFor(&mutex_, remaining) && block_for_collection_)) {
+        return false;
+      }
+    }
   }
 
   // Collection may have been cancelled while blocking for it.
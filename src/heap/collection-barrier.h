@@ -48,6 +48,20 @@ class CollectionBarrier {
   // Returns whether a GC was performed.
   bool AwaitCollectionBackground(LocalHeap* local_heap);
 
+  // Same as above, but stops waiting after the timeout expires, in which case
+  // false is returned. The GC stays requested.
+  bool AwaitCollectionBackground(LocalHeap* local_heap,
+                                 base::TimeDelta timeout);
+
+  // Called by the main thread around waits which can depend on background
+  // threads making progress, such as waiting on an ordered lock when
+  // replaying. While the main thread is blocked it can't perform the GC, so
+  // background threads stop waiting for it and the GC stays requested.
+  void SetMainThreadBlocked(bool blocked);
+
+  // Returns true while the main thread is blocked as above.
+  bool IsMainThreadBlocked() const { return main_thread_blocked_.load(); }
+
  private:
   // Activate stack guards and posting a task to perform the GC.
   void ActivateStackGuardAndPostTask();
@@ -72,6 +86,10 @@ class CollectionBarrier {
 
   // Will be set as soon as Isolate starts tear down.
   bool shutdown_requested_ = false;
+
+  // Set while the main thread is blocked and can't perform a GC. Updated
+  // without holding the mutex, see SetMainThreadBlocked().
+  std::atomic<bool> main_thread_blocked_{false};
 };
 
 }  // namespace internal
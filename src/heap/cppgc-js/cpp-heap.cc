@@ -706,7 +706,13 @@ void CppHeap::InitializeTracing(CollectionType collection_type,
       *collection_type_, StackState::kNoHeapPointers, SelectMarkingType(),
       IsForceGC(current_gc_flags_)
           ? cppgc::internal::MarkingConfig::IsForcedGC::kForced
-          : cppgc::internal::MarkingConfig::IsForcedGC::kNotForced};
+          : cppgc::internal::MarkingConfig::IsForcedGC::kNotForced,
+      // Deterministic incremental marking advances the marker only from V8's
+      // allocation driven steps, see AdvanceTracingWithBytes.
+      v8_flags.deterministic_incremental_marking
+          ? cppgc::internal::MarkingConfig::IncrementalStepping::
+                kExplicitBytesOnly
+          : cppgc::internal::MarkingConfig::IncrementalStepping::kScheduled};
   DCHECK_IMPLIES(!isolate_,
                  (MarkingType::kAtomic == marking_config.marking_type) ||
                      force_incremental_marking_for_testing_);
@@ -761,6 +767,17 @@ bool CppHeap::AdvanceTracing(double max_duration) {
   return marking_done_;
 }
 
+bool CppHeap::AdvanceTracingWithBytes(size_t marked_bytes) {
+  DCHECK(!in_atomic_pause_);
+  DCHECK_NOT_NULL(marker_);
+  is_in_v8_marking_step_ = true;
+  cppgc::internal::StatsCollector::EnabledScope stats_scope(
+      stats_collector(), cppgc::internal::StatsCollector::kIncrementalMark);
+  marking_done_ = marker_->AdvanceMarkingWithBytes(marked_bytes);
+  is_in_v8_marking_step_ = false;
+  return marking_done_;
+}
+
 bool CppHeap::IsTracingDone() { return marking_done_; }
 
 void CppHeap::EnterFinalPause(cppgc::EmbedderStackState stack_state) {
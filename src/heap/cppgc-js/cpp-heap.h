@@ -142,6 +142,7 @@ class V8_EXPORT_PRIVATE CppHeap final
   void InitializeTracing(CollectionType, GarbageCollectionFlags);
   void StartTracing();
   bool AdvanceTracing(double max_duration);
+  bool AdvanceTracingWithBytes(size_t marked_bytes);
   bool IsTracingDone();
   void TraceEpilogue();
   void EnterFinalPause(cppgc::EmbedderStackState stack_state);
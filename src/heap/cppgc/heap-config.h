@@ -22,6 +22,12 @@ struct MarkingConfig {
     kNotForced,
     kForced,
   };
+  // Whether incremental marking is advanced by the marker's own tasks and
+  // allocation steps, or only by explicit steps with a marked bytes limit.
+  enum class IncrementalStepping : uint8_t {
+    kScheduled,
+    kExplicitBytesOnly,
+  };
 
   static constexpr MarkingConfig Default() { return {}; }
 
@@ -29,6 +35,7 @@ struct MarkingConfig {
   StackState stack_state = StackState::kMayContainHeapPointers;
   MarkingType marking_type = MarkingType::kIncremental;
   IsForcedGC is_forced_gc = IsForcedGC::kNotForced;
+  IncrementalStepping incremental_stepping = IncrementalStepping::kScheduled;
 };
 
 struct SweepingConfig {
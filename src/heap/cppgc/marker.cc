@@ -473,6 +473,10 @@ bool MarkerBase::VisitCrossThreadPersistentsIfNeeded() {
 
 void MarkerBase::ScheduleIncrementalMarkingTask() {
   DCHECK(platform_);
+  if (config_.incremental_stepping ==
+      MarkingConfig::IncrementalStepping::kExplicitBytesOnly) {
+    return;
+  }
   if (!foreground_task_runner_ || incremental_marking_handle_) return;
   incremental_marking_handle_ =
       IncrementalMarkingTask::Post(foreground_task_runner_.get(), this);
@@ -492,6 +496,10 @@ bool MarkerBase::IncrementalMarkingStep(StackState stack_state) {
 }
 
 void MarkerBase::AdvanceMarkingOnAllocation() {
+  if (config_.incremental_stepping ==
+      MarkingConfig::IncrementalStepping::kExplicitBytesOnly) {
+    return;
+  }
   StatsCollector::EnabledScope stats_scope(heap().stats_collector(),
                                            StatsCollector::kIncrementalMark);
   StatsCollector::EnabledScope nested_scope(heap().stats_collector(),
@@ -556,6 +564,13 @@ bool MarkerBase::AdvanceMarkingWithLimits(v8::base::TimeDelta max_duration,
   return is_done;
 }
 
+bool MarkerBase::AdvanceMarkingWithBytes(size_t marked_bytes) {
+  DCHECK_LT(0u, marked_bytes);
+  return AdvanceMarkingWithLimits(
+      v8::base::TimeDelta::Max(),
+      mutator_marking_state_.marked_bytes() + marked_bytes);
+}
+
 bool MarkerBase::ProcessWorklistsWithDeadline(
     size_t marked_bytes_deadline, v8::base::TimeTicks time_deadline) {
   StatsCollector::EnabledScope stats_scope(
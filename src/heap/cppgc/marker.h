@@ -81,6 +81,10 @@ class V8_EXPORT_PRIVATE MarkerBase {
       v8::base::TimeDelta = kMaximumIncrementalStepDuration,
       size_t marked_bytes_limit = 0);
 
+  // Makes marking progress by marking at least |marked_bytes| more bytes on
+  // the mutator thread, without a time limit.
+  bool AdvanceMarkingWithBytes(size_t marked_bytes);
+
   // Signals leaving the atomic marking pause. This method expects no more
   // objects to be marked and merely updates marking states if needed.
   void LeaveAtomicPause();
@@ -4,6 +4,9 @@
 
 #include "src/heap/embedder-tracing.h"
 
+#include <limits>
+
+
 #include "include/v8-cppgc.h"
 #include "src/base/logging.h"
 #include "src/handles/global-handles.h"
@@ -105,6 +108,16 @@ bool LocalEmbedderHeapTracer::Trace(double max_duration) {
                    : remote_tracer_->AdvanceTracing(max_duration);
 }
 
+bool LocalEmbedderHeapTracer::TraceWithBytes(size_t marked_bytes) {
+  if (!InUse()) return true;
+
+  // Remote tracers only support time limits, and finish tracing in one step
+  // when given an unbounded one.
+  return cpp_heap_ ? cpp_heap_->AdvanceTracingWithBytes(marked_bytes)
+                   : remote_tracer_->AdvanceTracing(
+                         std::numeric_limits<double>::infinity());
+}
+
 bool LocalEmbedderHeapTracer::IsRemoteTracingDone() {
   return !InUse() || (cpp_heap_ ? cpp_heap()->IsTracingDone()
                                 : remote_tracer_->IsTracingDone());
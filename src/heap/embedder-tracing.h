@@ -107,6 +107,8 @@ class V8_EXPORT_PRIVATE LocalEmbedderHeapTracer final {
   void TraceEpilogue();
   void EnterFinalPause();
   bool Trace(double deadline);
+  // Trace without a time limit until at least |marked_bytes| have been marked.
+  bool TraceWithBytes(size_t marked_bytes);
   bool IsRemoteTracingDone();
 
   bool ShouldFinalizeIncrementalMarking() {
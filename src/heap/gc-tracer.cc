@@ -64,7 +64,11 @@ GCTracer::Event::Event(Type type, State state,
       young_object_size(0),
       survived_young_object_size(0),
       incremental_marking_bytes(0),
-      incremental_marking_duration(0.0) {
+      incremental_marking_duration(0.0),
+      scavenger_tasks(0),
+      scavenger_task_max_duration(0.0),
+      scavenger_task_total_duration(0.0),
+      scavenger_task_max_bytes(0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -623,6 +627,16 @@ void GCTracer::AddCompactionEvent(double duration,
       MakeBytesAndDuration(live_bytes_compacted, duration));
 }
 
+void GCTracer::AddScavengerTaskStats(double duration, size_t bytes) {
+  DCHECK_EQ(Event::SCAVENGER, current_.type);
+  current_.scavenger_tasks++;
+  current_.scavenger_task_max_duration =
+      std::max(current_.scavenger_task_max_duration, duration);
+  current_.scavenger_task_total_duration += duration;
+  current_.scavenger_task_max_bytes =
+      std::max(current_.scavenger_task_max_bytes, bytes);
+}
+
 void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
 }
@@ -748,6 +762,10 @@ void GCTracer::PrintNVP() const {
           "scavenge.weak_global_handles.identify=%.2f "
           "scavenge.weak_global_handles.process=%.2f "
           "scavenge.parallel=%.2f "
+          "scavenge.parallel.tasks=%d "
+          "scavenge.parallel.task_max=%.2f "
+          "scavenge.parallel.task_total=%.2f "
+          "scavenge.parallel.task_max_bytes=%zu "
           "scavenge.update_refs=%.2f "
           "scavenge.sweep_array_buffers=%.2f "
           "background.scavenge.parallel=%.2f "
@@ -789,6 +807,9 @@ void GCTracer::PrintNVP() const {
           current_scope(Scope::SCAVENGER_SCAVENGE_WEAK_GLOBAL_HANDLES_IDENTIFY),
           current_scope(Scope::SCAVENGER_SCAVENGE_WEAK_GLOBAL_HANDLES_PROCESS),
           current_scope(Scope::SCAVENGER_SCAVENGE_PARALLEL),
+          current_.scavenger_tasks, current_.scavenger_task_max_duration,
+          current_.scavenger_task_total_duration,
+          current_.scavenger_task_max_bytes,
           current_scope(Scope::SCAVENGER_SCAVENGE_UPDATE_REFS),
           current_scope(Scope::SCAVENGER_SWEEP_ARRAY_BUFFERS),
           current_scope(Scope::SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL),
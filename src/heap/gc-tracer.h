@@ -190,6 +190,17 @@ class V8_EXPORT_PRIVATE GCTracer {
     // INCREMENTAL_MARK_COMPACTOR.
     double incremental_marking_duration;
 
+    // Number of parallel scavenger tasks for SCAVENGER.
+    int scavenger_tasks;
+
+    // Longest and accumulated time (in ms) spent by scavenger tasks in the
+    // parallel phase for SCAVENGER.
+    double scavenger_task_max_duration;
+    double scavenger_task_total_duration;
+
+    // Most bytes copied or promoted by a single scavenger task for SCAVENGER.
+    size_t scavenger_task_max_bytes;
+
     // Amounts of time (in ms) spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
 
@@ -291,6 +302,9 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void AddCompactionEvent(double duration, size_t live_bytes_compacted);
 
+  // Log the work done by a single scavenger task in the parallel phase.
+  void AddScavengerTaskStats(double duration, size_t bytes);
+
   void AddSurvivalRatio(double survival_ratio);
 
   // Log an incremental marking step.
@@ -421,6 +435,7 @@ class V8_EXPORT_PRIVATE GCTracer {
   FRIEND_TEST(GCTracerTest, MutatorUtilization);
   FRIEND_TEST(GCTracerTest, RecordMarkCompactHistograms);
   FRIEND_TEST(GCTracerTest, RecordScavengerHistograms);
+  FRIEND_TEST(GCTracerTest, ScavengerTaskStats);
 
   struct BackgroundCounter {
     double total_duration_ms;
@@ -419,6 +419,32 @@ size_t Heap::CommittedMemoryExecutable() {
   return static_cast<size_t>(memory_allocator()->SizeExecutable());
 }
 
+size_t Heap::HugePageBackedMemory() {
+  if (!HasBeenSetUp() || !v8_flags.transparent_huge_pages) return 0;
+  // Reading the OS's memory statistics isn't supported when recording or
+  // replaying.
+  if (recordreplay::IsRecordingOrReplaying()) return 0;
+
+  // Parsing /proc/self/smaps is far too slow to do on every
+  // GetHeapStatistics() call.
+  const double now = MonotonicallyIncreasingTimeInMs();
+  if (huge_page_backed_memory_time_ms_ > 0 &&
+      now - huge_page_backed_memory_time_ms_ <
+          kHugePageBackedMemoryRefreshIntervalMs) {
+    return huge_page_backed_memory_;
+  }
+
+  std::vector<base::OS::MemoryRange> ranges;
+  memory_allocator()->AddHugePageRanges(&ranges);
+  if (code_range_ && code_range_->huge_pages_advised()) {
+    const Address begin = code_range_->page_allocator()->begin();
+    ranges.push_back({begin, begin + code_range_->page_allocator()->size()});
+  }
+  huge_page_backed_memory_ = base::OS::GetHugePageBackedSize(ranges);
+  huge_page_backed_memory_time_ms_ = now;
+  return huge_page_backed_memory_;
+}
+
 void Heap::UpdateMaximumCommitted() {
   if (!HasBeenSetUp()) return;
 
@@ -1361,6 +1387,9 @@ bool GCCallbacksScope::CheckReenter() const {
 }
 
 void Heap::HandleGCRequest() {
+  if (memory_reducer_) {
+    memory_reducer_->HandleProgressTimer();
+  }
   if (IsStressingScavenge() && stress_scavenge_observer_->HasRequestedGC()) {
     CollectAllGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
     stress_scavenge_observer_->RequestedGCDone();
@@ -2045,6 +2074,10 @@ void Heap::CheckCollectionRequested() {
                     current_gc_callback_flags_);
 }
 
+void Heap::SetMainThreadWaitingOnOrderedLock(bool waiting) {
+  collection_barrier_->SetMainThreadBlocked(waiting);
+}
+
 #if V8_ENABLE_WEBASSEMBLY
 void Heap::EnsureWasmCanonicalRttsSize(int length) {
   HandleScope scope(isolate());
@@ -2298,6 +2331,9 @@ bool Heap::CollectGarbageFromAnyThread(LocalHeap* local_heap,
         main_thread_local_heap()->state_.SetCollectionRequested();
 
     if (old_state.IsRunning()) {
+      // When replaying the main thread might be waiting on an ordered lock
+      // which this thread is next in line to acquire. The wait returns early
+      // without a GC in this case, see SetMainThreadWaitingOnOrderedLock().
       const bool performed_gc =
           collection_barrier_->AwaitCollectionBackground(local_heap);
       return performed_gc;
@@ -5070,6 +5106,8 @@ bool Heap::AllocationLimitOvershotByLargeMargin() {
 }
 
 bool Heap::ShouldOptimizeForLoadTime() {
+  // This depends on the time since loading started.
+  if (v8_flags.deterministic_incremental_marking) return false;
   return isolate()->rail_mode() == PERFORMANCE_LOAD &&
          !AllocationLimitOvershotByLargeMargin() &&
          MonotonicallyIncreasingTimeInMs() <
@@ -5084,11 +5122,6 @@ bool Heap::ShouldOptimizeForLoadTime() {
 bool Heap::ShouldExpandOldGenerationOnSlowAllocation(LocalHeap* local_heap) {
   replayio::AutoDisallowEvents disallow("Heap::ShouldExpandOldGenerationOnSlowAllocation");
 
-  // Always allow background threads to allocate while replaying without triggering GC.
-  // Waiting on a main thread GC can introduce deadlocks if the main thread
-  // is itself waiting on an ordered lock which this thread is next in line to acquire.
-  if (recordreplay::IsReplaying() && !local_heap->is_main_thread()) return true;
-
   if (always_allocate() || OldGenerationSpaceAvailable() > 0) return true;
   // We reached the old generation allocation limit.
 
@@ -5103,6 +5136,11 @@ bool Heap::ShouldExpandOldGenerationOnSlowAllocation(LocalHeap* local_heap) {
   // Make it more likely that retry of allocation on background thread succeeds
   if (IsRetryOfFailedAllocation(local_heap)) return true;
 
+  // The main thread is waiting on an ordered lock when replaying and can't
+  // perform the GC, which might be requested already. Allow the allocation
+  // so this thread can get to the lock.
+  if (collection_barrier_->IsMainThreadBlocked()) return true;
+
   // Background thread requested GC, allocation should fail
   if (CollectionRequested()) return false;
 
@@ -5116,8 +5154,10 @@ bool Heap::ShouldExpandOldGenerationOnSlowAllocation(LocalHeap* local_heap) {
 
   if (incremental_marking()->IsStopped() &&
       IncrementalMarkingLimitReached() == IncrementalMarkingLimit::kNoLimit &&
-      // Incremental marking is disabled when recording/replaying.
-      !recordreplay::IsRecordingOrReplaying("gc-changes", "NoIncrementalMarking")) {
+      // Incremental marking is disabled when recording/replaying, unless it
+      // is deterministic.
+      (v8_flags.deterministic_incremental_marking ||
+       !recordreplay::IsRecordingOrReplaying("gc-changes", "NoIncrementalMarking"))) {
     // We cannot start incremental marking.
     return false;
   }
@@ -764,6 +764,13 @@ class Heap {
 
   void CheckCollectionRequested();
 
+  // Called when replaying around main thread waits on ordered locks. Background
+  // threads might be next in line to acquire the lock, so they must not block
+  // on a GC from the main thread during the wait.
+  void SetMainThreadWaitingOnOrderedLock(bool waiting);
+
+  CollectionBarrier* collection_barrier() { return collection_barrier_.get(); }
+
   void RestoreHeapLimit(size_t heap_limit) {
     // Do not set the limit lower than the live size + some slack.
     size_t min_limit = SizeOfObjects() + SizeOfObjects() / 4;
@@ -1331,6 +1338,12 @@ class Heap {
   // Returns the amount of executable memory currently committed for the heap.
   size_t CommittedMemoryExecutable();
 
+  // Returns an estimate of how much of the old space and the code range is
+  // currently backed by transparent huge pages. See --transparent-huge-pages.
+  // Computing it reads the OS's memory statistics, so the result is cached
+  // for kHugePageBackedMemoryRefreshIntervalMs.
+  size_t HugePageBackedMemory();
+
   // Returns the amount of physical memory currently committed for the heap.
   size_t CommittedPhysicalMemory();
 
@@ -1957,6 +1970,8 @@ class Heap {
   // v8 browsing benchmarks.
   static const int kMaxLoadTimeMs = 7000;
 
+  static constexpr double kHugePageBackedMemoryRefreshIntervalMs = 1000;
+
   bool ShouldOptimizeForLoadTime();
 
   size_t old_generation_allocation_limit() const {
@@ -2134,6 +2149,10 @@ class Heap {
   size_t maximum_committed_ = 0;
   size_t old_generation_capacity_after_bootstrap_ = 0;
 
+  // Cached result of HugePageBackedMemory() and when it was computed.
+  size_t huge_page_backed_memory_ = 0;
+  double huge_page_backed_memory_time_ms_ = 0;
+
   // Backing store bytes (array buffers and external strings).
   // Use uint64_t counter since the counter could overflow the 32-bit range
   // temporarily on 32-bit.
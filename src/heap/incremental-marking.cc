@@ -185,7 +185,7 @@ void IncrementalMarking::Start(GarbageCollector garbage_collector,
   old_generation_allocation_counter_ = heap_->OldGenerationAllocationCounter();
   bytes_marked_ = 0;
   scheduled_bytes_to_mark_ = 0;
-  schedule_update_time_ms_ = start_time_ms_;
+  schedule_update_time_ms_ = ScheduleTimeMs();
   bytes_marked_concurrently_ = 0;
 
   if (is_major) {
@@ -592,6 +592,36 @@ void IncrementalMarking::EmbedderStep(double expected_duration_ms,
   *duration_ms = current - start;
 }
 
+void IncrementalMarking::DeterministicEmbedderStep(size_t expected_bytes,
+                                                   double* duration_ms) {
+  DCHECK(IsMarking());
+  DCHECK(v8_flags.deterministic_incremental_marking);
+  if (!heap_->local_embedder_heap_tracer()
+           ->SupportsIncrementalEmbedderSteps()) {
+    *duration_ms = 0.0;
+    return;
+  }
+
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_INCREMENTAL_EMBEDDER_TRACING);
+  LocalEmbedderHeapTracer* local_tracer = heap_->local_embedder_heap_tracer();
+  // Time is only measured for statistics.
+  const double start = heap_->MonotonicallyIncreasingTimeInMs();
+  if (local_marking_worklists()->PublishWrapper()) {
+    DCHECK(local_marking_worklists()->IsWrapperEmpty());
+  } else {
+    // Handing wrappers over to the embedder is cheap compared to tracing
+    // them, so all of them are processed.
+    LocalEmbedderHeapTracer::ProcessingScope scope(local_tracer);
+    HeapObject object;
+    while (local_marking_worklists()->PopWrapper(&object)) {
+      scope.TracePossibleWrapper(JSObject::cast(object));
+    }
+  }
+  local_tracer->TraceWithBytes(expected_bytes);
+  local_tracer->SetEmbedderWorklistEmpty(true);
+  *duration_ms = heap_->MonotonicallyIncreasingTimeInMs() - start;
+}
+
 bool IncrementalMarking::Stop() {
   if (IsStopped()) return false;
 
@@ -731,6 +761,22 @@ void IncrementalMarking::FastForwardScheduleIfCloseToFinalization() {
   }
 }
 
+extern uint64_t* gProgressCounter;
+
+// Execution progress which counts as one millisecond when scheduling
+// deterministic incremental marking work.
+static const uint64_t kRecordReplayProgressPerMs = 1000;
+
+double IncrementalMarking::ScheduleTimeMs() const {
+  if (!v8_flags.deterministic_incremental_marking) {
+    return heap()->MonotonicallyIncreasingTimeInMs();
+  }
+  if (!recordreplay::IsRecordingOrReplaying() || !gProgressCounter) {
+    return 0.0;
+  }
+  return static_cast<double>(*gProgressCounter / kRecordReplayProgressPerMs);
+}
+
 void IncrementalMarking::ScheduleBytesToMarkBasedOnTime(double time_ms) {
   // Time interval that should be sufficient to complete incremental marking.
   constexpr double kTargetMarkingWallTimeInMs = 500;
@@ -753,6 +799,9 @@ void IncrementalMarking::ScheduleBytesToMarkBasedOnTime(double time_ms) {
 }
 
 void IncrementalMarking::AdvanceAndFinalizeIfComplete() {
+  // This is used by tasks and idle notifications, which don't happen at
+  // deterministic points.
+  if (v8_flags.deterministic_incremental_marking) return;
   ScheduleBytesToMarkBasedOnTime(heap()->MonotonicallyIncreasingTimeInMs());
   if (v8_flags.fast_forward_schedule) {
     FastForwardScheduleIfCloseToFinalization();
@@ -789,11 +838,18 @@ void IncrementalMarking::AdvanceOnAllocation() {
   }
 
   ScheduleBytesToMarkBasedOnAllocation();
+  if (v8_flags.deterministic_incremental_marking) {
+    // There are no tasks to schedule work over time, so the progress based
+    // schedule is applied here.
+    ScheduleBytesToMarkBasedOnTime(ScheduleTimeMs());
+  }
   Step(kMaxStepSizeInMs, StepOrigin::kV8);
 
   if (IsMajorMarkingComplete()) {
     // Marking cannot be finalized here. Schedule a completion task instead.
-    if (!ShouldWaitForTask()) {
+    // Deterministic marking never uses tasks, and finalizes at the next stack
+    // guard check.
+    if (v8_flags.deterministic_incremental_marking || !ShouldWaitForTask()) {
       // When task isn't run soon enough, fall back to stack guard to force
       // completion.
       collection_requested_via_stack_guard_ = true;
@@ -937,8 +993,12 @@ void IncrementalMarking::Step(double max_step_size_in_ms,
   }
   // The first step after Scavenge will see many allocated bytes.
   // Cap the step size to distribute the marking work more uniformly.
+  // Deterministic marking ignores the measured marking speed, so the cap uses
+  // the initial conservative speed estimate.
   const double marking_speed =
-      heap()->tracer()->IncrementalMarkingSpeedInBytesPerMillisecond();
+      v8_flags.deterministic_incremental_marking
+          ? 0
+          : heap()->tracer()->IncrementalMarkingSpeedInBytesPerMillisecond();
   size_t max_step_size = GCIdleTimeHandler::EstimateMarkingStepSize(
       max_step_size_in_ms, marking_speed);
   bytes_to_process =
@@ -954,13 +1014,17 @@ void IncrementalMarking::Step(double max_step_size_in_ms,
   std::tie(v8_bytes_processed, std::ignore) =
       major_collector_->ProcessMarkingWorklist(bytes_to_process);
   if (heap_->local_embedder_heap_tracer()->InUse()) {
-    embedder_deadline =
-        std::min(max_step_size_in_ms,
-                 static_cast<double>(bytes_to_process) / marking_speed);
-    // TODO(chromium:1056170): Replace embedder_deadline with bytes_to_process
-    // after migrating blink to the cppgc library and after v8 can directly
-    // push objects to Oilpan.
-    EmbedderStep(embedder_deadline, &embedder_duration);
+    if (v8_flags.deterministic_incremental_marking) {
+      DeterministicEmbedderStep(bytes_to_process, &embedder_duration);
+    } else {
+      embedder_deadline =
+          std::min(max_step_size_in_ms,
+                   static_cast<double>(bytes_to_process) / marking_speed);
+      // TODO(chromium:1056170): Replace embedder_deadline with
+      // bytes_to_process after migrating blink to the cppgc library and after
+      // v8 can directly push objects to Oilpan.
+      EmbedderStep(embedder_deadline, &embedder_duration);
+    }
   }
   bytes_marked_ += v8_bytes_processed;
 
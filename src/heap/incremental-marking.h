@@ -184,6 +184,9 @@ class V8_EXPORT_PRIVATE IncrementalMarking final {
   void StartMarkingMinor();
 
   void EmbedderStep(double expected_duration_ms, double* duration_ms);
+  // Embedder step for deterministic incremental marking, which is limited by
+  // the bytes to mark instead of time.
+  void DeterministicEmbedderStep(size_t expected_bytes, double* duration_ms);
 
   void StartBlackAllocation();
   void PauseBlackAllocation();
@@ -194,6 +197,10 @@ class V8_EXPORT_PRIVATE IncrementalMarking final {
   // Updates scheduled_bytes_to_mark_ to ensure marking progress based on
   // time.
   void ScheduleBytesToMarkBasedOnTime(double time_ms);
+  // Time used by ScheduleBytesToMarkBasedOnTime. With deterministic
+  // incremental marking this is derived from the execution progress counter
+  // when recording or replaying, and never advances otherwise.
+  double ScheduleTimeMs() const;
   // Updates scheduled_bytes_to_mark_ to ensure marking progress based on
   // allocations.
   void ScheduleBytesToMarkBasedOnAllocation();
@@ -304,6 +304,8 @@ class PageMarkingItem : public ParallelWorkItem {
 
   void Process(YoungGenerationMarkingTask* task);
 
+  MemoryChunk* chunk() const { return chunk_; }
+
  private:
   inline Heap* heap() { return chunk_->heap(); }
 
@@ -10,6 +10,7 @@
 
 #include "src/base/logging.h"
 #include "src/base/optional.h"
+#include "src/base/platform/platform.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/common/globals.h"
@@ -41,6 +42,7 @@
 #include "src/heap/marking-state-inl.h"
 #include "src/heap/marking-visitor-inl.h"
 #include "src/heap/marking-visitor.h"
+#include "src/heap/memory-allocator.h"
 #include "src/heap/memory-chunk-layout.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/memory-measurement-inl.h"
@@ -4243,6 +4245,7 @@ class PageEvacuationJob : public v8::JobTask {
         evacuation_items_(std::move(evacuation_items)),
         remaining_evacuation_items_(evacuation_items_.size()),
         generator_(evacuation_items_.size()),
+        numa_aware_(isolate->heap()->memory_allocator()->numa_aware()),
         tracer_(isolate->heap()->tracer()) {}
 
   void Run(JobDelegate* delegate) override {
@@ -4259,6 +4262,22 @@ class PageEvacuationJob : public v8::JobTask {
   }
 
   void ProcessItems(JobDelegate* delegate, Evacuator* evacuator) {
+    if (V8_UNLIKELY(numa_aware_)) {
+      // Start with the pages on this thread's NUMA node. Pages on nodes
+      // without an evacuator thread are left to the loop below.
+      const int numa_node = base::OS::GetCurrentNumaNode();
+      if (numa_node >= 0) {
+        for (auto& work_item : evacuation_items_) {
+          if (work_item.second->numa_node() != numa_node) continue;
+          if (!work_item.first.TryAcquire()) continue;
+          evacuator->EvacuatePage(work_item.second);
+          if (remaining_evacuation_items_.fetch_sub(
+                  1, std::memory_order_relaxed) <= 1) {
+            return;
+          }
+        }
+      }
+    }
     while (remaining_evacuation_items_.load(std::memory_order_relaxed) > 0) {
       base::Optional<size_t> index = generator_.GetNext();
       if (!index) return;
@@ -4290,6 +4309,7 @@ class PageEvacuationJob : public v8::JobTask {
   std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> evacuation_items_;
   std::atomic<size_t> remaining_evacuation_items_{0};
   IndexGenerator generator_;
+  const bool numa_aware_;
 
   GCTracer* tracer_;
 };
@@ -6087,6 +6107,25 @@ void YoungGenerationMarkingJob::ProcessMarkingItems(
   // seeds the worklists from the old-to-new remembered set, but does not empty
   // them (this is done concurrently). The class should be refactored to make
   // this clearer.
+  if (V8_UNLIKELY(heap_->memory_allocator()->numa_aware())) {
+    // Start with the pages on this thread's NUMA node. Pages on nodes without
+    // a marking thread are left to the loop below.
+    const int numa_node = base::OS::GetCurrentNumaNode();
+    if (numa_node >= 0) {
+      for (auto& work_item : marking_items_) {
+        if (work_item.chunk()->numa_node() != numa_node) continue;
+        if (!work_item.TryAcquire()) continue;
+        work_item.Process(task);
+        if (!incremental()) {
+          task->EmptyMarkingWorklist();
+        }
+        if (remaining_marking_items_.fetch_sub(
+                1, std::memory_order_relaxed) <= 1) {
+          return;
+        }
+      }
+    }
+  }
   while (remaining_marking_items_.load(std::memory_order_relaxed) > 0) {
     base::Optional<size_t> index = generator_.GetNext();
     if (!index) return;
@@ -7,6 +7,7 @@
 #include <cinttypes>
 
 #include "src/base/address-region.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
@@ -41,8 +42,25 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate,
       size_executable_(0),
       lowest_ever_allocated_(static_cast<Address>(-1ll)),
       highest_ever_allocated_(kNullAddress),
+      // Which pooled pages get reused affects heap addresses, so node
+      // placement is left to the OS when recording or replaying.
+      numa_aware_(v8_flags.numa_aware_page_allocation &&
+                  !recordreplay::IsRecordingOrReplaying() &&
+                  base::OS::NumberOfNumaNodes() > 1),
+      // Grouping changes which addresses pages get, so it is disabled when
+      // recording or replaying as well. Grouping is pointless if a page
+      // already spans a whole huge page.
+      huge_page_size_(v8_flags.transparent_huge_pages &&
+                              !recordreplay::IsRecordingOrReplaying() &&
+                              base::OS::HugePageSize() >=
+                                  2 * static_cast<size_t>(Page::kPageSize)
+                          ? base::OS::HugePageSize()
+                          : 0),
       unmapper_(isolate->heap(), this) {
   DCHECK_NOT_NULL(code_page_allocator);
+  if (numa_aware_) {
+    unmapper_.numa_pooled_chunks_.resize(base::OS::NumberOfNumaNodes());
+  }
 }
 
 void MemoryAllocator::TearDown() {
@@ -58,6 +76,10 @@ void MemoryAllocator::TearDown() {
     reserved_chunk_at_virtual_memory_limit_->Free();
   }
 
+  // Regions are freed together with their last page.
+  DCHECK(huge_page_regions_.empty());
+  DCHECK(huge_page_regions_with_free_pages_.empty());
+
   code_page_allocator_ = nullptr;
   data_page_allocator_ = nullptr;
 }
@@ -164,14 +186,22 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kRegular)) != nullptr) {
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
+    // The header is inaccessible once the chunk is uncommitted.
+    int numa_node = chunk->numa_node();
     allocator_->PerformFreeMemory(chunk);
-    if (pooled) AddMemoryChunkSafe(ChunkQueueType::kPooled, chunk);
+    if (pooled) AddPooledMemoryChunkSafe(chunk, numa_node);
     if (delegate && delegate->ShouldYield()) return;
   }
   if (mode == MemoryAllocator::Unmapper::FreeMode::kFreePooled) {
     // The previous loop uncommitted any pages marked as pooled and added them
     // to the pooled list. In case of kFreePooled we need to free them though as
     // well.
+    int numa_node;
+    while ((chunk = GetPooledMemoryChunkOnNumaNodeSafe(-1, &numa_node)) !=
+           nullptr) {
+      allocator_->FreePooledChunk(chunk);
+      if (delegate && delegate->ShouldYield()) return;
+    }
     while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled)) != nullptr) {
       allocator_->FreePooledChunk(chunk);
       if (delegate && delegate->ShouldYield()) return;
@@ -180,12 +210,48 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
 
+void MemoryAllocator::Unmapper::AddPooledMemoryChunkSafe(MemoryChunk* chunk,
+                                                         int numa_node) {
+  base::MutexGuard guard(&mutex_);
+  if (numa_node >= 0 &&
+      static_cast<size_t>(numa_node) < numa_pooled_chunks_.size()) {
+    numa_pooled_chunks_[numa_node].push_back(chunk);
+  } else {
+    chunks_[ChunkQueueType::kPooled].push_back(chunk);
+  }
+}
+
+MemoryChunk* MemoryAllocator::Unmapper::GetPooledMemoryChunkOnNumaNodeSafe(
+    int numa_node, int* chunk_numa_node) {
+  base::MutexGuard guard(&mutex_);
+  if (numa_pooled_chunks_.empty()) return nullptr;
+  const int number_of_nodes = static_cast<int>(numa_pooled_chunks_.size());
+  // Start with the requested node and fall back to chunks pooled for other
+  // nodes before giving up.
+  const int first = numa_node >= 0 && numa_node < number_of_nodes ? numa_node
+                                                                   : 0;
+  for (int i = 0; i < number_of_nodes; i++) {
+    int node = (first + i) % number_of_nodes;
+    std::vector<MemoryChunk*>& chunks = numa_pooled_chunks_[node];
+    if (chunks.empty()) continue;
+    MemoryChunk* chunk = chunks.back();
+    chunks.pop_back();
+    *chunk_numa_node = node;
+    return chunk;
+  }
+  return nullptr;
+}
+
 void MemoryAllocator::Unmapper::TearDown() {
   CHECK(!job_handle_ || !job_handle_->IsValid());
   PerformFreeMemoryOnQueuedChunks(FreeMode::kFreePooled);
   for (int i = 0; i < ChunkQueueType::kNumberOfChunkQueues; i++) {
     DCHECK(chunks_[i].empty());
   }
+  for (auto& chunks : numa_pooled_chunks_) {
+    DCHECK(chunks.empty());
+    USE(chunks);
+  }
 }
 
 size_t MemoryAllocator::Unmapper::NumberOfCommittedChunks() {
@@ -200,6 +266,9 @@ int MemoryAllocator::Unmapper::NumberOfChunks() {
   for (int i = 0; i < ChunkQueueType::kNumberOfChunkQueues; i++) {
     result += chunks_[i].size();
   }
+  for (auto& chunks : numa_pooled_chunks_) {
+    result += chunks.size();
+  }
   return static_cast<int>(result);
 }
 
@@ -222,6 +291,117 @@ bool MemoryAllocator::Unmapper::IsRunning() const {
   return job_handle_ && job_handle_->IsValid();
 }
 
+int MemoryAllocator::PreferCurrentNumaNode(Address base, size_t size) {
+  DCHECK(numa_aware_);
+  int numa_node = base::OS::GetCurrentNumaNode();
+  if (numa_node < 0 || !base::OS::SetPreferredNumaNode(
+                           reinterpret_cast<void*>(base), size, numa_node)) {
+    return -1;
+  }
+  return numa_node;
+}
+
+bool MemoryAllocator::UsesHugePageRegions(BaseSpace* space,
+                                          Executability executable,
+                                          PageSize page_size) const {
+  return huge_page_size_ > 0 && space->identity() == OLD_SPACE &&
+         executable == NOT_EXECUTABLE && page_size == PageSize::kRegular;
+}
+
+Address MemoryAllocator::AllocatePageInHugePageRegion(
+    void* hint, VirtualMemory* controller, int* numa_node) {
+  DCHECK_LT(0, huge_page_size_);
+  const size_t pages_per_region = huge_page_size_ / MemoryChunk::kPageSize;
+  base::MutexGuard guard(&huge_page_regions_mutex_);
+
+  // Fill up existing regions before reserving new ones. Taking the lowest
+  // region with free pages keeps the heap compact.
+  Address region_start = kNullAddress;
+  HugePageRegion* region = nullptr;
+  if (!huge_page_regions_with_free_pages_.empty()) {
+    region_start = *huge_page_regions_with_free_pages_.begin();
+    auto it = huge_page_regions_.find(region_start);
+    DCHECK(it != huge_page_regions_.end());
+    region = &it->second;
+  } else {
+    VirtualMemory reservation(data_page_allocator(), huge_page_size_, hint,
+                              huge_page_size_);
+    if (!reservation.IsReserved()) {
+      return HandleAllocationFailure(NOT_EXECUTABLE);
+    }
+    region_start = reservation.address();
+    // Commit the whole region up front. Changing the permissions of single
+    // pages would split the huge page again.
+    if (!reservation.SetPermissions(region_start, huge_page_size_,
+                                    PageAllocator::kReadWrite)) {
+      return HandleAllocationFailure(NOT_EXECUTABLE);
+    }
+    UpdateAllocatedSpaceLimits(region_start, region_start + huge_page_size_);
+    base::OS::AdviseHugePages(reinterpret_cast<void*>(region_start),
+                              huge_page_size_);
+    region = &huge_page_regions_[region_start];
+    region->reservation = std::move(reservation);
+    region->used_pages.resize(pages_per_region, false);
+    // Setting the node per page would split the huge page as well.
+    if (V8_UNLIKELY(numa_aware_)) {
+      region->numa_node = PreferCurrentNumaNode(region_start, huge_page_size_);
+    }
+    huge_page_regions_with_free_pages_.insert(region_start);
+  }
+
+  size_t index = 0;
+  while (region->used_pages[index]) index++;
+  DCHECK_LT(index, pages_per_region);
+  region->used_pages[index] = true;
+  if (++region->used_page_count == pages_per_region) {
+    huge_page_regions_with_free_pages_.erase(region_start);
+  }
+
+  const Address base = region_start + index * MemoryChunk::kPageSize;
+  *controller = VirtualMemory(data_page_allocator(), base,
+                              static_cast<size_t>(MemoryChunk::kPageSize));
+  *numa_node = region->numa_node;
+  return base;
+}
+
+bool MemoryAllocator::IsInHugePageRegion(MemoryChunk* chunk) {
+  if (huge_page_size_ == 0) return false;
+  base::MutexGuard guard(&huge_page_regions_mutex_);
+  return huge_page_regions_.count(
+             RoundDown(chunk->address(), huge_page_size_)) != 0;
+}
+
+bool MemoryAllocator::FreePageInHugePageRegion(MemoryChunk* chunk) {
+  DCHECK_LT(0, huge_page_size_);
+  base::MutexGuard guard(&huge_page_regions_mutex_);
+  auto it =
+      huge_page_regions_.find(RoundDown(chunk->address(), huge_page_size_));
+  if (it == huge_page_regions_.end()) return false;
+  HugePageRegion& region = it->second;
+  const size_t index = (chunk->address() - it->first) / MemoryChunk::kPageSize;
+  DCHECK(region.used_pages[index]);
+  region.used_pages[index] = false;
+  region.used_page_count--;
+  // The page's own reservation only aliases part of the region.
+  chunk->reserved_memory()->Reset();
+  if (region.used_page_count == 0) {
+    huge_page_regions_with_free_pages_.erase(it->first);
+    region.reservation.Free();
+    huge_page_regions_.erase(it);
+  } else {
+    huge_page_regions_with_free_pages_.insert(it->first);
+  }
+  return true;
+}
+
+void MemoryAllocator::AddHugePageRanges(
+    std::vector<base::OS::MemoryRange>* ranges) {
+  base::MutexGuard guard(&huge_page_regions_mutex_);
+  for (auto& entry : huge_page_regions_) {
+    ranges->push_back({entry.first, entry.first + huge_page_size_});
+  }
+}
+
 bool MemoryAllocator::CommitMemory(VirtualMemory* reservation) {
   Address base = reservation->address();
   size_t size = reservation->size();
@@ -363,10 +543,22 @@ MemoryAllocator::AllocateUninitializedChunk(BaseSpace* space, size_t area_size,
   size_t chunk_size = ComputeChunkSize(area_size, executable);
   DCHECK_EQ(chunk_size % GetCommitPageSize(), 0);
 
-  Address base =
-      AllocateAlignedMemory(chunk_size, area_size, MemoryChunk::kAlignment,
-                            executable, address_hint, &reservation);
-  if (base == kNullAddress) return {};
+  Address base;
+  int numa_node = -1;
+  if (V8_UNLIKELY(UsesHugePageRegions(space, executable, page_size))) {
+    DCHECK_EQ(chunk_size, static_cast<size_t>(MemoryChunk::kPageSize));
+    base = AllocatePageInHugePageRegion(address_hint, &reservation, &numa_node);
+    if (base == kNullAddress) return {};
+  } else {
+    base = AllocateAlignedMemory(chunk_size, area_size, MemoryChunk::kAlignment,
+                                 executable, address_hint, &reservation);
+    if (base == kNullAddress) return {};
+    // Pages are only backed by physical memory when first touched, which
+    // happens below at the earliest.
+    if (V8_UNLIKELY(numa_aware_)) {
+      numa_node = PreferCurrentNumaNode(base, chunk_size);
+    }
+  }
 
   size_ += reservation.size();
 
@@ -401,7 +593,7 @@ MemoryAllocator::AllocateUninitializedChunk(BaseSpace* space, size_t area_size,
 
   return MemoryChunkAllocationResult{
       reinterpret_cast<void*>(base), chunk_size, area_start, area_end,
-      std::move(reservation),
+      std::move(reservation), numa_node,
   };
 }
 
@@ -516,6 +708,10 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
   DCHECK(!chunk->InReadOnlySpace());
   chunk->ReleaseAllAllocatedMemory();
 
+  if (V8_UNLIKELY(huge_page_size_ > 0) && FreePageInHugePageRegion(chunk)) {
+    return;
+  }
+
   VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
     UncommitMemory(reservation);
@@ -578,6 +774,7 @@ Page* MemoryAllocator::AllocatePage(MemoryAllocator::AllocationMode alloc_mode,
   Page* page = new (chunk_info->start) Page(
       isolate_->heap(), space, chunk_info->size, chunk_info->area_start,
       chunk_info->area_end, std::move(chunk_info->reservation), executable);
+  page->set_numa_node(chunk_info->numa_node);
 
 #ifdef DEBUG
   if (page->executable()) RegisterExecutableMemoryChunk(page);
@@ -618,6 +815,7 @@ LargePage* MemoryAllocator::AllocateLargePage(LargeObjectSpace* space,
   LargePage* page = new (chunk_info->start) LargePage(
       isolate_->heap(), space, chunk_info->size, chunk_info->area_start,
       chunk_info->area_end, std::move(chunk_info->reservation), executable);
+  page->set_numa_node(chunk_info->numa_node);
 
 #ifdef DEBUG
   if (page->executable()) RegisterExecutableMemoryChunk(page);
@@ -629,10 +827,21 @@ LargePage* MemoryAllocator::AllocateLargePage(LargeObjectSpace* space,
 
 base::Optional<MemoryAllocator::MemoryChunkAllocationResult>
 MemoryAllocator::AllocateUninitializedPageFromPool(Space* space) {
-  void* chunk = unmapper()->TryGetPooledMemoryChunkSafe();
+  int numa_node = -1;
+  if (V8_UNLIKELY(numa_aware_)) {
+    numa_node = base::OS::GetCurrentNumaNode();
+  }
+  int chunk_numa_node;
+  void* chunk =
+      unmapper()->TryGetPooledMemoryChunkSafe(numa_node, &chunk_numa_node);
   if (chunk == nullptr) return {};
   const int size = MemoryChunk::kPageSize;
   const Address start = reinterpret_cast<Address>(chunk);
+  if (numa_node >= 0 && chunk_numa_node != numa_node) {
+    // The chunk was pooled for another node. Pages which are still resident
+    // stay where they are, but pages faulted in from now on are local.
+    numa_node = PreferCurrentNumaNode(start, size);
+  }
   const Address area_start =
       start +
       MemoryChunkLayout::ObjectStartOffsetInMemoryChunk(space->identity());
@@ -647,7 +856,7 @@ MemoryAllocator::AllocateUninitializedPageFromPool(Space* space) {
 
   size_ += size;
   return MemoryChunkAllocationResult{
-      chunk, size, area_start, area_end, std::move(reservation),
+      chunk, size, area_start, area_end, std::move(reservation), numa_node,
   };
 }
 
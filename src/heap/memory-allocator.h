@@ -6,7 +6,9 @@
 #define V8_HEAP_MEMORY_ALLOCATOR_H_
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -16,6 +18,7 @@
 #include "src/base/export-template.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 #include "src/base/platform/semaphore.h"
 #include "src/common/globals.h"
 #include "src/heap/basic-memory-chunk.h"
@@ -51,20 +54,32 @@ class MemoryAllocator {
     }
 
     void AddMemoryChunkSafe(MemoryChunk* chunk) {
-      if (!chunk->IsLargePage() && chunk->executable() != EXECUTABLE) {
+      // Pages carved from a huge page region must go back to that region, so
+      // they can't be stolen for the pool.
+      if (!chunk->IsLargePage() && chunk->executable() != EXECUTABLE &&
+          !allocator_->IsInHugePageRegion(chunk)) {
         AddMemoryChunkSafe(ChunkQueueType::kRegular, chunk);
       } else {
         AddMemoryChunkSafe(ChunkQueueType::kNonRegular, chunk);
       }
     }
 
-    MemoryChunk* TryGetPooledMemoryChunkSafe() {
+    // Returns a pooled chunk, preferring one on |numa_node| if the pool is
+    // partitioned by node. |chunk_numa_node| is set to the node the chunk was
+    // pooled for, or -1 if unknown.
+    MemoryChunk* TryGetPooledMemoryChunkSafe(int numa_node,
+                                             int* chunk_numa_node) {
       // Procedure:
       // (1) Try to get a chunk that was declared as pooled and already has
-      // been uncommitted.
+      // been uncommitted, preferring chunks pooled for |numa_node|.
       // (2) Try to steal any memory chunk of kPageSize that would've been
       // uncommitted.
-      MemoryChunk* chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled);
+      *chunk_numa_node = -1;
+      MemoryChunk* chunk =
+          GetPooledMemoryChunkOnNumaNodeSafe(numa_node, chunk_numa_node);
+      if (chunk == nullptr) {
+        chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled);
+      }
       if (chunk == nullptr) {
         chunk = GetMemoryChunkSafe(ChunkQueueType::kRegular);
         if (chunk != nullptr) {
@@ -120,6 +135,13 @@ class MemoryAllocator {
       return chunk;
     }
 
+    // Adds an uncommitted pooled chunk to the partition for |numa_node|, or to
+    // the kPooled queue if the node is unknown.
+    void AddPooledMemoryChunkSafe(MemoryChunk* chunk, int numa_node);
+
+    MemoryChunk* GetPooledMemoryChunkOnNumaNodeSafe(int numa_node,
+                                                    int* chunk_numa_node);
+
     bool MakeRoomForNewTasks();
 
     void PerformFreeMemoryOnQueuedChunks(FreeMode mode,
@@ -132,6 +154,9 @@ class MemoryAllocator {
     MemoryAllocator* const allocator_;
     base::Mutex mutex_;
     std::vector<MemoryChunk*> chunks_[ChunkQueueType::kNumberOfChunkQueues];
+    // Pooled chunks partitioned by the NUMA node their memory was requested
+    // from. Empty unless the allocator is NUMA-aware.
+    std::vector<std::vector<MemoryChunk*>> numa_pooled_chunks_;
     std::unique_ptr<v8::JobHandle> job_handle_;
 
     friend class MemoryAllocator;
@@ -259,6 +284,17 @@ class MemoryAllocator {
 
   Unmapper* unmapper() { return &unmapper_; }
 
+  // Whether pages are placed on the NUMA node of the allocating thread. Only
+  // true with --numa-aware-page-allocation on machines with multiple nodes.
+  bool numa_aware() const { return numa_aware_; }
+
+  // Adds the regions old space pages are grouped into for transparent huge
+  // pages to |ranges|. See --transparent-huge-pages.
+  void AddHugePageRanges(std::vector<base::OS::MemoryRange>* ranges);
+
+  // Whether |chunk| was carved from one of those regions.
+  bool IsInHugePageRegion(MemoryChunk* chunk);
+
   void UnregisterReadOnlyPage(ReadOnlyPage* page);
 
   Address HandleAllocationFailure(Executability executable);
@@ -283,6 +319,7 @@ class MemoryAllocator {
     size_t area_start;
     size_t area_end;
     VirtualMemory reservation;
+    int numa_node = -1;
   };
 
   // Computes the size of a MemoryChunk from the size of the object_area and
@@ -301,6 +338,33 @@ class MemoryAllocator {
                                 size_t alignment, Executability executable,
                                 void* hint, VirtualMemory* controller);
 
+  // Asks the OS to back the given region with memory from the NUMA node of the
+  // calling thread. Returns that node, or -1 if the preference wasn't set.
+  int PreferCurrentNumaNode(Address base, size_t size);
+
+  // Old space pages are carved from huge page sized regions which are only
+  // returned to the OS once all of their pages are freed, so that freeing
+  // single pages doesn't split huge pages.
+  struct HugePageRegion {
+    VirtualMemory reservation;
+    std::vector<bool> used_pages;
+    size_t used_page_count = 0;
+    int numa_node = -1;
+  };
+
+  bool UsesHugePageRegions(BaseSpace* space, Executability executable,
+                           PageSize page_size) const;
+
+  // Returns the address of a committed page from a huge page region, or
+  // kNullAddress if no region could be reserved. |numa_node| is set to the
+  // node the region's memory was requested from.
+  Address AllocatePageInHugePageRegion(void* hint, VirtualMemory* controller,
+                                       int* numa_node);
+
+  // Returns a page to its huge page region, freeing the region if it was the
+  // last page in use. Returns false if the page isn't from a region.
+  bool FreePageInHugePageRegion(MemoryChunk* chunk);
+
   // Commit memory region owned by given reservation object.  Returns true if
   // it succeeded and false otherwise.
   bool CommitMemory(VirtualMemory* reservation);
@@ -413,6 +477,16 @@ class MemoryAllocator {
   std::atomic<Address> highest_ever_allocated_;
 
   base::Optional<VirtualMemory> reserved_chunk_at_virtual_memory_limit_;
+  const bool numa_aware_;
+
+  // Size of the regions old space pages are grouped into, or 0 if pages are
+  // not grouped.
+  const size_t huge_page_size_;
+  std::map<Address, HugePageRegion> huge_page_regions_;
+  // Start addresses of the regions which have unused pages.
+  std::set<Address> huge_page_regions_with_free_pages_;
+  base::Mutex huge_page_regions_mutex_;
+
   Unmapper unmapper_;
 
 #ifdef DEBUG
@@ -224,6 +224,10 @@ class MemoryChunk : public BasicMemoryChunk {
   void ClearWasUsedForAllocation() { was_used_for_allocation_ = false; }
   bool WasUsedForAllocation() const { return was_used_for_allocation_; }
 
+  // NUMA node the chunk's memory was requested from, or -1 if unknown.
+  int numa_node() const { return static_cast<int>(numa_node_); }
+  void set_numa_node(int node) { numa_node_ = node; }
+
  protected:
   // Release all memory allocated by the chunk. Should be called when memory
   // chunk is about to be freed.
@@ -295,6 +299,9 @@ class MemoryChunk : public BasicMemoryChunk {
   // only for new space pages.
   size_t was_used_for_allocation_ = false;
 
+  // See numa_node(). Only tracked with --numa-aware-page-allocation.
+  intptr_t numa_node_ = -1;
+
  private:
   friend class ConcurrentMarkingState;
   friend class MarkingState;
@@ -4,6 +4,8 @@
 
 #include "src/heap/memory-reducer.h"
 
+#include <type_traits>
+
 #include "src/flags/flags.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
@@ -18,6 +20,7 @@ const int MemoryReducer::kLongDelayMs = 8000;
 const int MemoryReducer::kShortDelayMs = 500;
 const int MemoryReducer::kWatchdogDelayMs = 100000;
 const int MemoryReducer::kMaxNumberOfGCs = 3;
+const uint64_t MemoryReducer::kRecordReplayProgressPerMs = 1000;
 const double MemoryReducer::kCommittedMemoryFactor = 1.1;
 const size_t MemoryReducer::kCommittedMemoryDelta = 10 * MB;
 
@@ -36,6 +39,11 @@ MemoryReducer::TimerTask::TimerTask(MemoryReducer* memory_reducer)
 
 void MemoryReducer::TimerTask::RunInternal() {
   Heap* heap = memory_reducer_->heap();
+  memory_reducer_->NotifyTimer(TimerEvent(heap));
+}
+
+// static
+MemoryReducer::Event MemoryReducer::TimerEvent(Heap* heap) {
   Event event;
   double time_ms = heap->MonotonicallyIncreasingTimeInMs();
   heap->tracer()->SampleAllocation(time_ms, heap->NewSpaceAllocationCounter(),
@@ -60,7 +68,67 @@ void MemoryReducer::TimerTask::RunInternal() {
       heap->incremental_marking()->IsStopped() &&
       (heap->incremental_marking()->CanBeStarted() || optimize_for_memory);
   event.committed_memory = heap->CommittedOldGenerationMemory();
-  memory_reducer_->NotifyTimer(event);
+  return AdjustEventTime(event);
+}
+
+// static
+bool MemoryReducer::UseProgressTimer() {
+  // The progress counter only advances for JS on the main thread.
+  return recordreplay::IsRecordingOrReplaying(
+             recordreplay::Feature::kGCChanges,
+             "MemoryReducer::ProgressTimer") &&
+         IsMainThread();
+}
+
+extern uint64_t* gProgressCounter;
+
+// static
+double MemoryReducer::ProgressTimeMs() {
+  return static_cast<double>(*gProgressCounter / kRecordReplayProgressPerMs);
+}
+
+// static
+MemoryReducer::Event MemoryReducer::AdjustEventTime(const Event& event) {
+  // Events can arrive with wall clock times from the heap, which must not be
+  // mixed with times from the progress clock.
+  Event adjusted = event;
+  if (UseProgressTimer()) {
+    adjusted.time_ms = ProgressTimeMs();
+  }
+  return adjusted;
+}
+
+void MemoryReducer::ProgressTimerObserver::Step(int bytes_allocated, Address,
+                                                size_t) {
+  memory_reducer_->OnProgressTimerStep();
+}
+
+void MemoryReducer::OnProgressTimerStep() {
+  if (!progress_timer_target_ || *gProgressCounter < progress_timer_target_) {
+    return;
+  }
+  progress_timer_target_ = 0;
+  // The observer is added again if the timer is rescheduled.
+  RemoveProgressTimerObserver();
+  if (state_.action != kWait || heap()->IsTearingDown()) return;
+  // Events are disallowed while allocation observers run, so the decision is
+  // made and recorded when the GC request is handled.
+  progress_timer_fired_ = true;
+  heap()->isolate()->stack_guard()->RequestGC();
+}
+
+void MemoryReducer::HandleProgressTimer() {
+  if (!progress_timer_fired_) return;
+  progress_timer_fired_ = false;
+  if (state_.action != kWait || heap()->IsTearingDown()) return;
+  NotifyTimer(TimerEvent(heap()));
+}
+
+void MemoryReducer::RemoveProgressTimerObserver() {
+  if (!progress_timer_observer_added_) return;
+  heap()->RemoveAllocationObserversFromAllSpaces(&progress_timer_observer_,
+                                                 &progress_timer_observer_);
+  progress_timer_observer_added_ = false;
 }
 
 
@@ -68,13 +136,32 @@ void MemoryReducer::NotifyTimer(const Event& event) {
   DCHECK_EQ(kTimer, event.type);
   DCHECK_EQ(kWait, state_.action);
   state_ = Step(state_, event);
+  if (UseProgressTimer()) {
+    // The inputs to the timer event depend on the heap's state and aren't
+    // deterministic, so the decision is recorded and used when replaying.
+    static_assert(std::is_trivially_copyable<State>::value);
+    recordreplay::RecordReplayBytes("MemoryReducer::NotifyTimer", &state_,
+                                    sizeof(state_));
+  }
   if (state_.action == kRun) {
-    DCHECK(heap()->incremental_marking()->IsStopped());
-    DCHECK(v8_flags.incremental_marking);
     if (v8_flags.trace_gc_verbose) {
       heap()->isolate()->PrintWithTimestamp("Memory reducer: started GC #%d\n",
                                             state_.started_gcs);
     }
+    if (UseProgressTimer() && (!v8_flags.incremental_marking ||
+                               !heap()->incremental_marking()->IsStopped())) {
+      // When replaying, the recorded decision can be to run while incremental
+      // marking is disabled or already in progress. Reduce the heap's memory
+      // at this point anyway, unless marking will finish on its own.
+      if (heap()->incremental_marking()->IsStopped()) {
+        heap()->CollectAllGarbage(Heap::kReduceMemoryFootprintMask,
+                                  GarbageCollectionReason::kMemoryReducer,
+                                  kGCCallbackFlagCollectAllExternalMemory);
+      }
+      return;
+    }
+    DCHECK(heap()->incremental_marking()->IsStopped());
+    DCHECK(v8_flags.incremental_marking);
     heap()->StartIdleIncrementalMarking(
         GarbageCollectionReason::kMemoryReducer,
         kGCCallbackFlagCollectAllExternalMemory);
@@ -97,8 +184,9 @@ void MemoryReducer::NotifyTimer(const Event& event) {
 }
 
 
-void MemoryReducer::NotifyMarkCompact(const Event& event) {
-  DCHECK_EQ(kMarkCompact, event.type);
+void MemoryReducer::NotifyMarkCompact(const Event& raw_event) {
+  DCHECK_EQ(kMarkCompact, raw_event.type);
+  Event event = AdjustEventTime(raw_event);
   Action old_action = state_.action;
   state_ = Step(state_, event);
   if (old_action != kWait && state_.action == kWait) {
@@ -114,8 +202,9 @@ void MemoryReducer::NotifyMarkCompact(const Event& event) {
   }
 }
 
-void MemoryReducer::NotifyPossibleGarbage(const Event& event) {
-  DCHECK_EQ(kPossibleGarbage, event.type);
+void MemoryReducer::NotifyPossibleGarbage(const Event& raw_event) {
+  DCHECK_EQ(kPossibleGarbage, raw_event.type);
+  Event event = AdjustEventTime(raw_event);
   Action old_action = state_.action;
   state_ = Step(state_, event);
   if (old_action != kWait && state_.action == kWait) {
@@ -202,8 +291,20 @@ MemoryReducer::State MemoryReducer::Step(const State& state,
 
 void MemoryReducer::ScheduleTimer(double delay_ms) {
   // Posting tasks non-deterministically with a delay is not currently supported
-  // when recording/replaying.
+  // when recording/replaying. On the main thread the timer fires instead when
+  // the progress counter advances by the equivalent amount.
   if (recordreplay::IsRecordingOrReplaying("gc-changes", "MemoryReducer::ScheduleTimer")) {
+    if (!UseProgressTimer() || heap()->IsTearingDown()) return;
+    DCHECK_LT(0, delay_ms);
+    progress_timer_target_ =
+        *gProgressCounter +
+        std::max<uint64_t>(1, static_cast<uint64_t>(delay_ms) *
+                                  kRecordReplayProgressPerMs);
+    if (!progress_timer_observer_added_) {
+      heap()->AddAllocationObserversToAllSpaces(&progress_timer_observer_,
+                                                &progress_timer_observer_);
+      progress_timer_observer_added_ = true;
+    }
     return;
   }
   DCHECK_LT(0, delay_ms);
@@ -214,7 +315,12 @@ void MemoryReducer::ScheduleTimer(double delay_ms) {
                                (delay_ms + kSlackMs) / 1000.0);
 }
 
-void MemoryReducer::TearDown() { state_ = State(kDone, 0, 0, 0.0, 0); }
+void MemoryReducer::TearDown() {
+  RemoveProgressTimerObserver();
+  progress_timer_target_ = 0;
+  progress_timer_fired_ = false;
+  state_ = State(kDone, 0, 0, 0.0, 0);
+}
 
 }  // namespace internal
 }  // namespace v8
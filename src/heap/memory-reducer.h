@@ -8,6 +8,7 @@
 #include "include/v8-platform.h"
 #include "src/base/macros.h"
 #include "src/common/globals.h"
+#include "src/heap/allocation-observer.h"
 #include "src/tasks/cancelable-task.h"
 
 namespace v8 {
@@ -126,11 +127,17 @@ class V8_EXPORT_PRIVATE MemoryReducer {
   static State Step(const State& state, const Event& event);
   // Posts a timer task that will call NotifyTimer after the given delay.
   void ScheduleTimer(double delay_ms);
+  // Called when handling a GC request from the stack guard, at which point
+  // the timer can fire if the progress counter has reached its target.
+  void HandleProgressTimer();
   void TearDown();
   static const int kLongDelayMs;
   static const int kShortDelayMs;
   static const int kWatchdogDelayMs;
   static const int kMaxNumberOfGCs;
+  // When recording or replaying, the memory reducer's clock is driven by the
+  // execution progress counter instead of wall time, at this rate.
+  static const uint64_t kRecordReplayProgressPerMs;
   // The committed memory has to increase by at least this factor since the
   // last run in order to trigger a new run after mark-compact.
   static const double kCommittedMemoryFactor;
@@ -159,8 +166,37 @@ class V8_EXPORT_PRIVATE MemoryReducer {
     MemoryReducer* memory_reducer_;
   };
 
+  // Checks whether the execution progress counter has reached the memory
+  // reducer's timer target when recording or replaying. This is checked at
+  // allocation points, as delayed tasks don't run at consistent points. Once
+  // the target is reached the timer fires at the next stack guard check,
+  // where events can be recorded.
+  class ProgressTimerObserver final : public AllocationObserver {
+   public:
+    static const intptr_t kStepSize = 256 * KB;
+
+    explicit ProgressTimerObserver(MemoryReducer* memory_reducer)
+        : AllocationObserver(kStepSize), memory_reducer_(memory_reducer) {}
+
+    void Step(int bytes_allocated, Address, size_t) override;
+
+   private:
+    MemoryReducer* memory_reducer_;
+  };
+
   void NotifyTimer(const Event& event);
 
+  // Whether the timer is driven by the execution progress counter.
+  static bool UseProgressTimer();
+  static double ProgressTimeMs();
+
+  // Use the progress clock for an event's time, if necessary.
+  static Event AdjustEventTime(const Event& event);
+
+  static Event TimerEvent(Heap* heap);
+  void OnProgressTimerStep();
+  void RemoveProgressTimerObserver();
+
   static bool WatchdogGC(const State& state, const Event& event);
 
   Heap* heap_;
@@ -170,6 +206,14 @@ class V8_EXPORT_PRIVATE MemoryReducer {
   double js_calls_sample_time_ms_;
   int start_delay_ms_ = false;
 
+  ProgressTimerObserver progress_timer_observer_{this};
+  bool progress_timer_observer_added_ = false;
+  // Progress counter value at which the timer fires, or zero.
+  uint64_t progress_timer_target_ = 0;
+  // Set when the progress timer target has been reached and the timer will
+  // fire at the next stack guard check.
+  bool progress_timer_fired_ = false;
+
   // Used in cctest.
   friend class heap::HeapTester;
 };
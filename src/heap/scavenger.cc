@@ -4,6 +4,7 @@
 
 #include "src/heap/scavenger.h"
 
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/array-buffer-sweeper.h"
@@ -15,6 +16,7 @@
 #include "src/heap/invalidated-slots-inl.h"
 #include "src/heap/mark-compact-inl.h"
 #include "src/heap/mark-compact.h"
+#include "src/heap/memory-allocator.h"
 #include "src/heap/memory-chunk-inl.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/objects-visiting-inl.h"
@@ -236,6 +238,7 @@ void ScavengerCollector::JobTask::ProcessItems(JobDelegate* delegate,
     ConcurrentScavengePages(scavenger);
     scavenger->Process(delegate);
   }
+  scavenger->AddScavengingTime(scavenging_time);
   if (v8_flags.trace_parallel_scavenge) {
     PrintIsolate(outer_->heap_->isolate(),
                  "scavenge[%p]: time=%.2f copied=%zu promoted=%zu\n",
@@ -246,6 +249,22 @@ void ScavengerCollector::JobTask::ProcessItems(JobDelegate* delegate,
 
 void ScavengerCollector::JobTask::ConcurrentScavengePages(
     Scavenger* scavenger) {
+  if (V8_UNLIKELY(outer_->heap_->memory_allocator()->numa_aware())) {
+    // Scavenge the pages on this thread's NUMA node first. Pages on nodes
+    // without a scavenger thread are left to the loop below.
+    const int numa_node = base::OS::GetCurrentNumaNode();
+    if (numa_node >= 0) {
+      for (auto& work_item : memory_chunks_) {
+        if (work_item.second->numa_node() != numa_node) continue;
+        if (!work_item.first.TryAcquire()) continue;
+        scavenger->ScavengePage(work_item.second);
+        if (remaining_memory_chunks_.fetch_sub(
+                1, std::memory_order_relaxed) <= 1) {
+          return;
+        }
+      }
+    }
+  }
   while (remaining_memory_chunks_.load(std::memory_order_relaxed) > 0) {
     base::Optional<size_t> index = generator_.GetNext();
     if (!index) return;
@@ -325,7 +344,6 @@ void ScavengerCollector::CollectGarbage() {
   DCHECK(surviving_new_large_objects_.empty());
   std::vector<std::unique_ptr<Scavenger>> scavengers;
   Scavenger::EmptyChunksList empty_chunks;
-  const int num_scavenge_tasks = NumberOfScavengeTasks();
   Scavenger::CopiedList copied_list;
   Scavenger::PromotionList promotion_list;
   EphemeronTableList ephemeron_table_list;
@@ -344,6 +362,13 @@ void ScavengerCollector::CollectGarbage() {
     filter_scope.FilterOldSpaceSweepingPages(
         [](Page* page) { return !page->ContainsSlots<OLD_TO_NEW>(); });
 
+    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks;
+    RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+        heap_, [&memory_chunks](MemoryChunk* chunk) {
+          memory_chunks.emplace_back(ParallelWorkItem{}, chunk);
+        });
+
+    const int num_scavenge_tasks = NumberOfScavengeTasks(memory_chunks.size());
     const bool is_logging = isolate_->log_object_relocation();
     for (int i = 0; i < num_scavenge_tasks; ++i) {
       scavengers.emplace_back(
@@ -351,12 +376,6 @@ void ScavengerCollector::CollectGarbage() {
                         &promotion_list, &ephemeron_table_list, i));
     }
 
-    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks;
-    RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
-        heap_, [&memory_chunks](MemoryChunk* chunk) {
-          memory_chunks.emplace_back(ParallelWorkItem{}, chunk);
-        });
-
     RootScavengeVisitor root_scavenge_visitor(scavengers[kMainThreadId].get());
 
     {
@@ -395,6 +414,11 @@ void ScavengerCollector::CollectGarbage() {
           ->Join();
       DCHECK(copied_list.IsEmpty());
       DCHECK(promotion_list.IsEmpty());
+      for (auto& scavenger : scavengers) {
+        heap_->tracer()->AddScavengerTaskStats(
+            scavenger->scavenging_time(),
+            scavenger->bytes_copied() + scavenger->bytes_promoted());
+      }
     }
 
     if (V8_UNLIKELY(v8_flags.scavenge_separate_stack_scanning)) {
@@ -572,16 +596,12 @@ void ScavengerCollector::MergeSurvivingNewLargeObjects(
   }
 }
 
-int ScavengerCollector::NumberOfScavengeTasks() {
+int ScavengerCollector::NumberOfScavengeTasks(size_t old_to_new_chunks) {
   if (!v8_flags.parallel_scavenge) return 1;
-  const int num_scavenge_tasks =
-      static_cast<int>(
-          SemiSpaceNewSpace::From(heap_->new_space())->TotalCapacity()) /
-          MB +
-      1;
   static int num_cores = V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1;
-  int tasks = std::max(
-      1, std::min({num_scavenge_tasks, kMaxScavengerTasks, num_cores}));
+  int tasks = NumberOfScavengeTasks(
+      SemiSpaceNewSpace::From(heap_->new_space())->Size(), old_to_new_chunks,
+      num_cores);
   if (!heap_->CanPromoteYoungAndExpandOldGeneration(
           static_cast<size_t>(tasks * Page::kPageSize))) {
     // Optimize for memory usage near the heap limit.
@@ -590,6 +610,26 @@ int ScavengerCollector::NumberOfScavengeTasks() {
   return tasks;
 }
 
+// static
+int ScavengerCollector::NumberOfScavengeTasks(size_t new_space_size,
+                                              size_t old_to_new_chunks,
+                                              int num_cores) {
+  // Scale with the amount of work available: the bytes allocated in new space
+  // since the last scavenge bound the objects to copy, and every page with
+  // old-to-new slots is a separate work item for the parallel phase.
+  static constexpr size_t kOldToNewChunksPerTask = 4;
+  const size_t new_space_tasks = new_space_size / MB + 1;
+  const size_t remembered_set_tasks =
+      old_to_new_chunks / kOldToNewChunksPerTask;
+  const int num_scavenge_tasks = static_cast<int>(std::min<size_t>(
+      new_space_tasks + remembered_set_tasks, kMaxScavengerTasks));
+  int max_tasks = std::min({kMaxScavengerTasks, num_cores});
+  if (v8_flags.scavenger_max_task_num > 0) {
+    max_tasks = std::min<int>(max_tasks, v8_flags.scavenger_max_task_num);
+  }
+  return std::max(1, std::min(num_scavenge_tasks, max_tasks));
+}
+
 Scavenger::PromotionList::Local::Local(Scavenger::PromotionList* promotion_list)
     : regular_object_promotion_list_local_(
           promotion_list->regular_object_promotion_list_),
@@ -732,6 +772,11 @@ void Scavenger::Process(JobDelegate* delegate) {
       done = false;
       if (delegate && ((++objects % kInterruptThreshold) == 0)) {
         if (!copied_list_local_.IsLocalEmpty()) {
+          // Other tasks can only steal published segments, so share local
+          // work once the global pool has run dry.
+          if (copied_list_local_.IsGlobalEmpty()) {
+            copied_list_local_.Publish();
+          }
           delegate->NotifyConcurrencyIncrease();
         }
       }
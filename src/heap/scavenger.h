@@ -111,6 +111,10 @@ class Scavenger {
   size_t bytes_copied() const { return copied_size_; }
   size_t bytes_promoted() const { return promoted_size_; }
 
+  // Time (in ms) this scavenger spent in the parallel phase.
+  double scavenging_time() const { return scavenging_time_; }
+  void AddScavengingTime(double time) { scavenging_time_ += time; }
+
  private:
   enum PromotionHeapChoice { kPromoteIntoLocalHeap, kPromoteIntoSharedHeap };
 
@@ -203,6 +207,7 @@ class Scavenger {
   PretenturingHandler::PretenuringFeedbackMap local_pretenuring_feedback_;
   size_t copied_size_;
   size_t promoted_size_;
+  double scavenging_time_ = 0.0;
   EvacuationAllocator allocator_;
   std::unique_ptr<ConcurrentAllocator> shared_old_allocator_;
   SurvivingNewLargeObjectsMap surviving_new_large_objects_;
@@ -265,13 +270,20 @@ class ScavengeVisitor final : public NewSpaceVisitor<ScavengeVisitor> {
 
 class ScavengerCollector {
  public:
-  static const int kMaxScavengerTasks = 8;
+  static const int kMaxScavengerTasks = 32;
   static const int kMainThreadId = 0;
 
   explicit ScavengerCollector(Heap* heap);
 
   void CollectGarbage();
 
+  // Number of tasks to use for a scavenge with |new_space_size| bytes in new
+  // space and |old_to_new_chunks| pages with old-to-new slots, when
+  // |num_cores| cores are available. Capped by --scavenger-max-task-num.
+  V8_EXPORT_PRIVATE static int NumberOfScavengeTasks(size_t new_space_size,
+                                                     size_t old_to_new_chunks,
+                                                     int num_cores);
+
  private:
   class JobTask : public v8::JobTask {
    public:
@@ -303,7 +315,7 @@ class ScavengerCollector {
   void MergeSurvivingNewLargeObjects(
       const SurvivingNewLargeObjectsMap& objects);
 
-  int NumberOfScavengeTasks();
+  int NumberOfScavengeTasks(size_t old_to_new_chunks);
 
   void ProcessWeakReferences(EphemeronTableList* ephemeron_table_list);
   void ClearYoungEphemerons(EphemeronTableList* ephemeron_table_list);
@@ -128,6 +128,8 @@ size_t Page::ShrinkToHighWaterMark() {
   // about address space fragmentation.
   VirtualMemory* reservation = reserved_memory();
   if (!reservation->IsReserved()) return 0;
+  // Pages carved from a huge page region can't return part of the region.
+  if (heap()->memory_allocator()->IsInHugePageRegion(this)) return 0;
 
   // Shrink pages to high water mark. The water mark points either to a filler
   // or the area_end.
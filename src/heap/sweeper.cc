@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "src/base/logging.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/flags/flags.h"
@@ -18,6 +19,7 @@
 #include "src/heap/gc-tracer.h"
 #include "src/heap/invalidated-slots-inl.h"
 #include "src/heap/mark-compact-inl.h"
+#include "src/heap/memory-allocator.h"
 #include "src/heap/new-spaces.h"
 #include "src/heap/paged-spaces.h"
 #include "src/heap/pretenuring-handler-inl.h"
@@ -194,7 +196,12 @@ void Sweeper::StartSweeping(GarbageCollector collector) {
 
 int Sweeper::NumberOfConcurrentSweepers() const {
   DCHECK(v8_flags.concurrent_sweeping);
-  return std::min(Sweeper::kMaxSweeperTasks,
+  int max_tasks = Sweeper::kMaxSweeperTasks;
+  if (v8_flags.concurrent_sweeping_max_worker_num > 0) {
+    max_tasks =
+        std::min<int>(max_tasks, v8_flags.concurrent_sweeping_max_worker_num);
+  }
+  return std::min(max_tasks,
                   V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1);
 }
 
@@ -266,7 +273,8 @@ bool Sweeper::AreSweeperTasksRunning() {
 
 V8_INLINE size_t Sweeper::FreeAndProcessFreedMemory(
     Address free_start, Address free_end, Page* page, Space* space,
-    FreeSpaceTreatmentMode free_space_treatment_mode) {
+    FreeSpaceTreatmentMode free_space_treatment_mode,
+    bool discard_unused_memory) {
   CHECK_GT(free_end, free_start);
   size_t freed_bytes = 0;
   size_t size = static_cast<size_t>(free_end - free_start);
@@ -276,7 +284,7 @@ V8_INLINE size_t Sweeper::FreeAndProcessFreedMemory(
   page->heap()->CreateFillerObjectAtSweeper(free_start, static_cast<int>(size));
   freed_bytes = reinterpret_cast<PagedSpaceBase*>(space)->UnaccountedFree(
       free_start, size);
-  if (should_reduce_memory_) page->DiscardUnusedMemory(free_start, size);
+  if (discard_unused_memory) page->DiscardUnusedMemory(free_start, size);
 
   return freed_bytes;
 }
@@ -377,8 +385,13 @@ int Sweeper::RawSweep(
   CodeObjectRegistry* code_object_registry = p->GetCodeObjectRegistry();
   std::vector<Address> code_objects;
 
+  // Discarding memory in a huge page region would split its huge page.
+  const bool discard_unused_memory =
+      should_reduce_memory_ &&
+      !heap_->memory_allocator()->IsInHugePageRegion(p);
+
   base::Optional<ActiveSystemPages> active_system_pages_after_sweeping;
-  if (should_reduce_memory_) {
+  if (discard_unused_memory) {
     // Only decrement counter when we discard unused system pages.
     active_system_pages_after_sweeping = ActiveSystemPages();
     active_system_pages_after_sweeping->Init(
@@ -432,7 +445,8 @@ int Sweeper::RawSweep(
       max_freed_bytes =
           std::max(max_freed_bytes,
                    FreeAndProcessFreedMemory(free_start, free_end, p, space,
-                                             free_space_treatment_mode));
+                                             free_space_treatment_mode,
+                                             discard_unused_memory));
       CleanupRememberedSetEntriesForFreedMemory(
           free_start, free_end, p, record_free_ranges, &free_ranges_map,
           sweeping_mode, &invalidated_old_to_new_cleanup,
@@ -466,7 +480,8 @@ int Sweeper::RawSweep(
     max_freed_bytes =
         std::max(max_freed_bytes,
                  FreeAndProcessFreedMemory(free_start, free_end, p, space,
-                                           free_space_treatment_mode));
+                                           free_space_treatment_mode,
+                                           discard_unused_memory));
     CleanupRememberedSetEntriesForFreedMemory(
         free_start, free_end, p, record_free_ranges, &free_ranges_map,
         sweeping_mode, &invalidated_old_to_new_cleanup,
@@ -652,14 +667,30 @@ void Sweeper::PrepareToBeSweptPage(AllocationSpace space, Page* page) {
 }
 
 Page* Sweeper::GetSweepingPageSafe(AllocationSpace space) {
+  int numa_node = -1;
+  if (V8_UNLIKELY(heap_->memory_allocator()->numa_aware())) {
+    numa_node = base::OS::GetCurrentNumaNode();
+  }
   base::MutexGuard guard(&mutex_);
   DCHECK(IsValidSweepingSpace(space));
   int space_index = GetSweepSpaceIndex(space);
-  Page* page = nullptr;
-  if (!sweeping_list_[space_index].empty()) {
-    page = sweeping_list_[space_index].back();
-    sweeping_list_[space_index].pop_back();
+  SweepingList& sweeping_list = sweeping_list_[space_index];
+  if (sweeping_list.empty()) return nullptr;
+  size_t index = sweeping_list.size() - 1;
+  if (numa_node >= 0) {
+    // Prefer one of the next few pages which lives on this thread's node.
+    // Looking further would undo the ordering by live bytes.
+    static constexpr size_t kNumaLookahead = 8;
+    const size_t limit = index >= kNumaLookahead ? index - kNumaLookahead : 0;
+    for (size_t i = index + 1; i-- > limit;) {
+      if (sweeping_list[i]->numa_node() == numa_node) {
+        index = i;
+        break;
+      }
+    }
   }
+  Page* page = sweeping_list[index];
+  sweeping_list.erase(sweeping_list.begin() + index);
   return page;
 }
 
@@ -123,7 +123,7 @@ class Sweeper {
 
   static const int kNumberOfSweepingSpaces =
       LAST_SWEEPABLE_SPACE - FIRST_SWEEPABLE_SPACE + 1;
-  static constexpr int kMaxSweeperTasks = 3;
+  static constexpr int kMaxSweeperTasks = 8;
 
   template <typename Callback>
   void ForAllSweepingSpaces(Callback callback) const {
@@ -142,7 +142,8 @@ class Sweeper {
   // the operating system.
   size_t FreeAndProcessFreedMemory(
       Address free_start, Address free_end, Page* page, Space* space,
-      FreeSpaceTreatmentMode free_space_treatment_mode);
+      FreeSpaceTreatmentMode free_space_treatment_mode,
+      bool discard_unused_memory);
 
   // Helper function for RawSweep. Handle remembered set entries in the freed
   // memory which require clearing.
@@ -3144,7 +3144,7 @@ void BytecodeGenerator::VisitObjectLiteral(ObjectLiteral* expr) {
     BuildCreateObjectLiteral(literal, flags, entry);
 
     // Check if any constant properties indicate the object should be tracked.
-    if (recordreplay::IsRecordingOrReplaying("emit-opcodes")) {
+    if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kEmitOpcodes)) {
       for (int i = 0; i < expr->properties()->length(); i++) {
         ObjectLiteral::Property* prop = expr->properties()->at(i);
         if (prop->is_computed_name()) break;
@@ -3951,7 +3951,7 @@ void BytecodeGenerator::BuildLoadNamedProperty(const Expression* object_expr,
 void BytecodeGenerator::BuildSetNamedProperty(const Expression* object_expr,
                                               Register object,
                                               const AstRawString* name) {
-  if (recordreplay::IsRecordingOrReplaying("emit-opcodes") &&
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kEmitOpcodes) &&
       !record_replay_has_track_this_ &&
       object_expr->IsThisExpression() &&
       RecordReplayTrackThisObjectAssignment(name->to_string())) {
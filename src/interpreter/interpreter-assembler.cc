@@ -1298,6 +1298,33 @@ void InterpreterAssembler::DispatchWide(OperandScale operand_scale) {
   DispatchToBytecodeHandlerEntry(target_code_entry, next_bytecode_offset);
 }
 
+void InterpreterAssembler::GotoIfRecordReplayInstrumentationEnabled(
+    Label* enabled) {
+  TNode<IntPtrT> instrumentation_enabled = UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(),
+           ExternalConstant(
+               ExternalReference::record_replay_instrumentation_enabled())));
+  GotoIf(WordNotEqual(instrumentation_enabled, IntPtrConstant(0)), enabled);
+
+  Label done(this);
+  TNode<IntPtrT> instrumented_functions = UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(),
+           ExternalConstant(
+               ExternalReference::record_replay_instrumented_functions())));
+  GotoIf(WordEqual(instrumented_functions, IntPtrConstant(0)), &done);
+
+  TNode<JSFunction> closure = CAST(LoadRegister(Register::function_closure()));
+  TNode<SharedFunctionInfo> shared = LoadObjectField<SharedFunctionInfo>(
+      closure, JSFunction::kSharedFunctionInfoOffset);
+  TNode<Uint8T> flags2 =
+      LoadObjectField<Uint8T>(shared, SharedFunctionInfo::kFlags2Offset);
+  GotoIf(IsSetWord32<SharedFunctionInfo::RecordReplayInstrumentedBit>(flags2),
+         enabled);
+  Goto(&done);
+
+  BIND(&done);
+}
+
 void InterpreterAssembler::UpdateInterruptBudgetOnReturn() {
   // TODO(rmcilroy): Investigate whether it is worth supporting self
   // optimization of primitive functions like FullCodegen.
@@ -239,6 +239,10 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
 
   TNode<Int8T> LoadOsrState(TNode<FeedbackVector> feedback_vector);
 
+  // Jump to |enabled| if record/replay instrumentation callbacks are enabled
+  // for the current function.
+  void GotoIfRecordReplayInstrumentationEnabled(Label* enabled);
+
   // Dispatch to the bytecode.
   void Dispatch();
 
@@ -2848,10 +2848,47 @@ IGNITION_HANDLER(IncBlockCounter, InterpreterAssembler) {
   Dispatch();
 }
 
+// RecordReplayIncExecutionProgressCounter
+//
+// Increment the execution progress counter inline. The runtime is only called
+// when the target progress is about to be reached or when progress asserts or
+// checks are enabled, in which case the runtime does the increment itself.
 IGNITION_HANDLER(RecordReplayIncExecutionProgressCounter, InterpreterAssembler) {
-  TNode<Context> context = GetContext();
-  TNode<Object> closure = LoadRegister(Register::function_closure());
-  CallRuntime(Runtime::kRecordReplayAssertExecutionProgress, context, closure);
+  Label runtime(this, Label::kDeferred), done(this);
+
+  TNode<Uint8T> assert_progress = UncheckedCast<Uint8T>(
+      Load(MachineType::Uint8(),
+           ExternalConstant(ExternalReference::record_replay_assert_progress())));
+  GotoIf(Word32NotEqual(assert_progress, Int32Constant(0)), &runtime);
+
+  TNode<IntPtrT> check_progress = UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(),
+           ExternalConstant(ExternalReference::record_replay_check_progress())));
+  GotoIf(WordNotEqual(check_progress, IntPtrConstant(0)), &runtime);
+
+  TNode<ExternalReference> counter_addr =
+      ExternalConstant(ExternalReference::record_replay_progress_counter());
+  TNode<UintPtrT> counter =
+      UncheckedCast<UintPtrT>(Load(MachineType::UintPtr(), counter_addr));
+  TNode<UintPtrT> new_counter = UintPtrAdd(counter, UintPtrConstant(1));
+  TNode<UintPtrT> target = UncheckedCast<UintPtrT>(
+      Load(MachineType::UintPtr(),
+           ExternalConstant(ExternalReference::record_replay_target_progress())));
+  GotoIf(WordEqual(new_counter, target), &runtime);
+  StoreNoWriteBarrier(MachineType::PointerRepresentation(), counter_addr,
+                      new_counter);
+  Goto(&done);
+
+  BIND(&runtime);
+  {
+    TNode<Context> context = GetContext();
+    TNode<Object> closure = LoadRegister(Register::function_closure());
+    CallRuntime(Runtime::kRecordReplayAssertExecutionProgress, context,
+                closure);
+    Goto(&done);
+  }
+
+  BIND(&done);
   Dispatch();
 }
 
@@ -2871,7 +2908,7 @@ IGNITION_HANDLER(ReplayIncJsFrameDepth, InterpreterAssembler) {
   Goto(&ok);
 
   BIND(&overflow);
-  CallRuntime(Runtime::kThrowStackOverflow, GetContext());
+  CallRuntime(Runtime::kRecordReplayThrowJsFrameDepthOverflow, GetContext());
   Abort(AbortReason::kUnexpectedReturnFromThrow);
   Unreachable();
 
@@ -2896,11 +2933,25 @@ IGNITION_HANDLER(RecordReplayNotifyActivity, InterpreterAssembler) {
   Dispatch();
 }
 
+// RecordReplayInstrumentation <index>
+//
+// Invoke the instrumentation callback for site <index>. The runtime is only
+// called when instrumentation is enabled.
 IGNITION_HANDLER(RecordReplayInstrumentation, InterpreterAssembler) {
-  TNode<Context> context = GetContext();
-  TNode<Object> closure = LoadRegister(Register::function_closure());
-  TNode<Smi> index = BytecodeOperandIdxSmi(0);
-  CallRuntime(Runtime::kRecordReplayInstrumentation, context, closure, index);
+  Label runtime(this, Label::kDeferred), done(this);
+  GotoIfRecordReplayInstrumentationEnabled(&runtime);
+  Goto(&done);
+
+  BIND(&runtime);
+  {
+    TNode<Context> context = GetContext();
+    TNode<Object> closure = LoadRegister(Register::function_closure());
+    TNode<Smi> index = BytecodeOperandIdxSmi(0);
+    CallRuntime(Runtime::kRecordReplayInstrumentation, context, closure, index);
+    Goto(&done);
+  }
+
+  BIND(&done);
   Dispatch();
 }
 
@@ -2914,13 +2965,27 @@ IGNITION_HANDLER(RecordReplayInstrumentationGenerator, InterpreterAssembler) {
   Dispatch();
 }
 
+// RecordReplayInstrumentationReturn <index> <return_value>
+//
+// Invoke the instrumentation callback for site <index> with the value being
+// returned. The runtime is only called when instrumentation is enabled.
 IGNITION_HANDLER(RecordReplayInstrumentationReturn, InterpreterAssembler) {
-  TNode<Context> context = GetContext();
-  TNode<Object> closure = LoadRegister(Register::function_closure());
-  TNode<Smi> index = BytecodeOperandIdxSmi(0);
-  TNode<Object> return_value = LoadRegisterAtOperandIndex(1);
-  CallRuntime(Runtime::kRecordReplayInstrumentationReturn,
-              context, closure, index, return_value);
+  Label runtime(this, Label::kDeferred), done(this);
+  GotoIfRecordReplayInstrumentationEnabled(&runtime);
+  Goto(&done);
+
+  BIND(&runtime);
+  {
+    TNode<Context> context = GetContext();
+    TNode<Object> closure = LoadRegister(Register::function_closure());
+    TNode<Smi> index = BytecodeOperandIdxSmi(0);
+    TNode<Object> return_value = LoadRegisterAtOperandIndex(1);
+    CallRuntime(Runtime::kRecordReplayInstrumentationReturn,
+                context, closure, index, return_value);
+    Goto(&done);
+  }
+
+  BIND(&done);
   Dispatch();
 }
 
@@ -394,6 +394,28 @@ class RuntimeCallTimer final {
   ADD_THREAD_SPECIFIC_COUNTER(V, PreParse, ArrowFunctionLiteral)            \
   ADD_THREAD_SPECIFIC_COUNTER(V, PreParse, WithVariableResolution)
 
+// Record/replay runtime hooks, split by the tier of the code which called
+// them. The counters for each hook must be in this order, see
+// RecordReplayHookCounterId. The execution progress counter and JS frame depth
+// hooks are done inline in every tier and only their runtime calls are
+// counted: RecordReplayAssertExecutionProgress when progress checks are
+// enabled or the target progress is reached, and
+// RecordReplayThrowJsFrameDepthOverflow when the frame depth limit is hit.
+#define ADD_RECORD_REPLAY_HOOK_COUNTERS(V, Hook) \
+  V(Hook##_Ignition)                             \
+  V(Hook##_Sparkplug)                            \
+  V(Hook##_Maglev)                               \
+  V(Hook##_TurboFan)
+
+#define FOR_EACH_RECORD_REPLAY_HOOK_COUNTER(V)                              \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayAssertExecutionProgress)   \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayAssertValue)               \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayInstrumentation)           \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayInstrumentationGenerator)  \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayInstrumentationReturn)     \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayTrackObjectId)             \
+  ADD_RECORD_REPLAY_HOOK_COUNTERS(V, RecordReplayThrowJsFrameDepthOverflow)
+
 #define FOR_EACH_MANUAL_COUNTER(V)             \
   V(AccessorGetterCallback)                    \
   V(AccessorSetterCallback)                    \
@@ -504,7 +526,8 @@ class RuntimeCallTimer final {
   V(WebSnapshotDeserialize_Symbols)            \
   V(WebSnapshotDeserialize_TypedArrays)        \
   V(WrappedFunctionLengthGetter)               \
-  V(WrappedFunctionNameGetter)
+  V(WrappedFunctionNameGetter)                 \
+  FOR_EACH_RECORD_REPLAY_HOOK_COUNTER(V)
 
 #define FOR_EACH_HANDLER_COUNTER(V)               \
   V(KeyedLoadIC_KeyedLoadSloppyArgumentsStub)     \
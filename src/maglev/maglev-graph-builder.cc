@@ -31,6 +31,10 @@
 #include "src/objects/property-details.h"
 #include "src/objects/slots-inl.h"
 
+namespace v8::internal {
+extern bool gRecordReplayAssertProgress;
+}  // namespace v8::internal
+
 namespace v8::internal::maglev {
 
 namespace {
@@ -3383,7 +3387,12 @@ void MaglevGraphBuilder::VisitIncBlockCounter() {
 
 void MaglevGraphBuilder::VisitRecordReplayIncExecutionProgressCounter() {
   ValueNode* closure = GetClosure();
-  BuildCallRuntime(Runtime::kRecordReplayAssertExecutionProgress, {closure});
+  // Progress asserts need the runtime for every increment.
+  if (gRecordReplayAssertProgress) {
+    BuildCallRuntime(Runtime::kRecordReplayAssertExecutionProgress, {closure});
+    return;
+  }
+  AddNewNode<ReplayIncrementProgressCounter>({closure});
 }
 
 void MaglevGraphBuilder::VisitReplayIncJsFrameDepth() {
@@ -3400,8 +3409,7 @@ void MaglevGraphBuilder::VisitRecordReplayNotifyActivity() {
 
 void MaglevGraphBuilder::VisitRecordReplayInstrumentation() {
   ValueNode* closure = GetClosure();
-  ValueNode* index = GetSmiConstant(iterator_.GetIndexOperand(0));
-  BuildCallRuntime(Runtime::kRecordReplayInstrumentation, {closure, index});
+  AddNewNode<ReplayInstrumentation>({closure}, iterator_.GetIndexOperand(0));
 }
 
 void MaglevGraphBuilder::VisitRecordReplayInstrumentationGenerator() {
@@ -3414,10 +3422,9 @@ void MaglevGraphBuilder::VisitRecordReplayInstrumentationGenerator() {
 
 void MaglevGraphBuilder::VisitRecordReplayInstrumentationReturn() {
   ValueNode* closure = GetClosure();
-  ValueNode* index = GetSmiConstant(iterator_.GetIndexOperand(0));
   ValueNode* return_value = LoadRegisterTagged(1);
-  BuildCallRuntime(Runtime::kRecordReplayInstrumentationReturn,
-                   {closure, index, return_value});
+  AddNewNode<ReplayInstrumentationReturn>({closure, return_value},
+                                          iterator_.GetIndexOperand(0));
 }
 
 void MaglevGraphBuilder::VisitRecordReplayAssertValue() {
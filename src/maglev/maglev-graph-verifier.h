@@ -144,6 +144,8 @@ class MaglevGraphVerifier {
       case Opcode::kTestUndetectable:
       case Opcode::kTestTypeOf:
       case Opcode::kThrowReferenceErrorIfHole:
+      case Opcode::kReplayIncrementProgressCounter:
+      case Opcode::kReplayInstrumentation:
       case Opcode::kThrowSuperNotCalledIfHole:
       case Opcode::kThrowSuperAlreadyCalledIfNotHole:
       case Opcode::kReturn:
@@ -192,6 +194,7 @@ class MaglevGraphVerifier {
       // TODO(victorgomes): Can we check that second input is a Smi?
       case Opcode::kStoreTaggedFieldWithWriteBarrier:
       case Opcode::kLoadNamedGeneric:
+      case Opcode::kReplayInstrumentationReturn:
       case Opcode::kThrowIfNotSuperConstructor:
       case Opcode::kToName:
       case Opcode::kToNumberOrNumeric:
@@ -3356,6 +3356,48 @@ void ReduceInterruptBudget::PrintParams(
   os << "(" << amount() << ")";
 }
 
+void ReplayIncrementProgressCounter::AllocateVreg(
+    MaglevVregAllocationState* vreg_state) {
+  UseAny(closure());
+  set_temporaries_needed(2);
+}
+void ReplayIncrementProgressCounter::GenerateCode(
+    MaglevAssembler* masm, const ProcessingState& state) {
+  RegList temps = general_temporaries();
+  Register address = temps.PopFirst();
+  Register counter = temps.PopFirst();
+  ZoneLabelRef done(masm);
+  DeferredCodeInfo* call_runtime = __ PushDeferredCode(
+      [](MaglevAssembler* masm, ZoneLabelRef done,
+         ReplayIncrementProgressCounter* node) {
+        {
+          SaveRegisterStateForCall save_register_state(
+              masm, node->register_snapshot());
+          __ Move(kContextRegister, masm->native_context().object());
+          __ PushInput(node->closure());
+          __ CallRuntime(Runtime::kRecordReplayAssertExecutionProgress, 1);
+          save_register_state.DefineSafepointWithLazyDeopt(
+              node->lazy_deopt_info());
+        }
+        __ jmp(*done);
+      },
+      done, this);
+
+  // The runtime increments the counter itself when it is called.
+  __ Move(address, ExternalReference::record_replay_check_progress());
+  __ cmpq(MemOperand(address, 0), Immediate(0));
+  __ j(not_equal, &call_runtime->deferred_code_label);
+  __ Move(address, ExternalReference::record_replay_progress_counter());
+  __ movq(counter, MemOperand(address, 0));
+  __ incq(counter);
+  __ Move(address, ExternalReference::record_replay_target_progress());
+  __ cmpq(counter, MemOperand(address, 0));
+  __ j(equal, &call_runtime->deferred_code_label);
+  __ Move(address, ExternalReference::record_replay_progress_counter());
+  __ movq(MemOperand(address, 0), counter);
+  __ bind(*done);
+}
+
 void ReplayIncrementAndCheckJsFrameDepth::AllocateVreg(
     MaglevVregAllocationState* vreg_state) {
   set_temporaries_needed(1);
@@ -3372,7 +3414,7 @@ void ReplayIncrementAndCheckJsFrameDepth::GenerateCode(
       greater_equal,
       [](MaglevAssembler* masm, ReplayIncrementAndCheckJsFrameDepth* node) {
         __ Move(kContextRegister, masm->native_context().object());
-        __ CallRuntime(Runtime::kThrowStackOverflow, 0);
+        __ CallRuntime(Runtime::kRecordReplayThrowJsFrameDepthOverflow, 0);
         masm->DefineExceptionHandlerAndLazyDeoptPoint(node);
         __ Abort(AbortReason::kUnexpectedReturnFromThrow);
       },
@@ -3392,6 +3434,103 @@ void ReplayDecrementJsFrameDepth::GenerateCode(MaglevAssembler* masm,
   __ decl(depth);
 }
 
+namespace {
+
+void PushReplayInstrumentationArguments(MaglevAssembler* masm,
+                                        ReplayInstrumentation* node) {
+  __ PushInput(node->closure());
+  __ Push(Smi::FromInt(node->index()));
+}
+
+void PushReplayInstrumentationArguments(MaglevAssembler* masm,
+                                        ReplayInstrumentationReturn* node) {
+  __ PushInput(node->closure());
+  __ Push(Smi::FromInt(node->index()));
+  __ PushInput(node->return_value());
+}
+
+// Call the instrumentation runtime function for a node in deferred code if
+// instrumentation is enabled, either everywhere or for the node's function.
+// This matches BaselineCompiler::JumpIfRecordReplayInstrumentationDisabled,
+// except that the function's flag is only checked in deferred code.
+template <typename NodeT>
+void GenerateReplayInstrumentation(MaglevAssembler* masm, NodeT* node,
+                                   Runtime::FunctionId function_id,
+                                   int argument_count) {
+  Register scratch = node->general_temporaries().first();
+  __ Move(scratch, ExternalReference::record_replay_instrumentation_enabled());
+  __ movq(scratch, MemOperand(scratch, 0));
+  __ Move(kScratchRegister,
+          ExternalReference::record_replay_instrumented_functions());
+  __ orq(scratch, MemOperand(kScratchRegister, 0));
+  ZoneLabelRef done(masm);
+  __ JumpToDeferredIf(
+      not_equal,
+      [](MaglevAssembler* masm, ZoneLabelRef done, NodeT* node,
+         Runtime::FunctionId function_id, int argument_count) {
+        Label call;
+        Register scratch = node->general_temporaries().first();
+        __ Move(scratch,
+                ExternalReference::record_replay_instrumentation_enabled());
+        __ cmpq(MemOperand(scratch, 0), Immediate(0));
+        __ j(not_equal, &call);
+        Register closure = __ FromAnyToRegister(node->closure(), scratch);
+        __ LoadTaggedPointerField(
+            scratch,
+            FieldOperand(closure, JSFunction::kSharedFunctionInfoOffset));
+        __ testb(
+            FieldOperand(scratch, SharedFunctionInfo::kFlags2Offset),
+            Immediate(SharedFunctionInfo::RecordReplayInstrumentedBit::kMask));
+        __ j(zero, *done);
+        __ bind(&call);
+        {
+          SaveRegisterStateForCall save_register_state(
+              masm, node->register_snapshot());
+          __ Move(kContextRegister, masm->native_context().object());
+          PushReplayInstrumentationArguments(masm, node);
+          __ CallRuntime(function_id, argument_count);
+          save_register_state.DefineSafepointWithLazyDeopt(
+              node->lazy_deopt_info());
+        }
+        __ jmp(*done);
+      },
+      done, node, function_id, argument_count);
+  __ bind(*done);
+}
+
+}  // namespace
+
+void ReplayInstrumentation::AllocateVreg(
+    MaglevVregAllocationState* vreg_state) {
+  UseAny(closure());
+  set_temporaries_needed(1);
+}
+void ReplayInstrumentation::GenerateCode(MaglevAssembler* masm,
+                                         const ProcessingState& state) {
+  GenerateReplayInstrumentation(masm, this,
+                                Runtime::kRecordReplayInstrumentation, 2);
+}
+void ReplayInstrumentation::PrintParams(
+    std::ostream& os, MaglevGraphLabeller* graph_labeller) const {
+  os << "(" << index() << ")";
+}
+
+void ReplayInstrumentationReturn::AllocateVreg(
+    MaglevVregAllocationState* vreg_state) {
+  UseAny(closure());
+  UseAny(return_value());
+  set_temporaries_needed(1);
+}
+void ReplayInstrumentationReturn::GenerateCode(MaglevAssembler* masm,
+                                               const ProcessingState& state) {
+  GenerateReplayInstrumentation(masm, this,
+                                Runtime::kRecordReplayInstrumentationReturn, 3);
+}
+void ReplayInstrumentationReturn::PrintParams(
+    std::ostream& os, MaglevGraphLabeller* graph_labeller) const {
+  os << "(" << index() << ")";
+}
+
 void ThrowReferenceErrorIfHole::AllocateVreg(
     MaglevVregAllocationState* vreg_state) {
   UseAny(value());
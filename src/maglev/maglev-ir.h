@@ -208,8 +208,11 @@ class CompactInterpreterFrameState;
   V(StoreTaggedFieldWithWriteBarrier) \
   V(IncreaseInterruptBudget)          \
   V(ReduceInterruptBudget)            \
+  V(ReplayIncrementProgressCounter)         \
   V(ReplayIncrementAndCheckJsFrameDepth)    \
   V(ReplayDecrementJsFrameDepth)            \
+  V(ReplayInstrumentation)                  \
+  V(ReplayInstrumentationReturn)            \
   V(ThrowReferenceErrorIfHole)        \
   V(ThrowSuperNotCalledIfHole)        \
   V(ThrowSuperAlreadyCalledIfNotHole) \
@@ -3691,6 +3694,24 @@ class ReduceInterruptBudget : public FixedInputNodeT<0, ReduceInterruptBudget> {
   const int amount_;
 };
 
+// Increments the execution progress counter, calling into the runtime when
+// the target progress is reached or progress checks are enabled.
+class ReplayIncrementProgressCounter
+    : public FixedInputNodeT<1, ReplayIncrementProgressCounter> {
+  using Base = FixedInputNodeT<1, ReplayIncrementProgressCounter>;
+
+ public:
+  explicit ReplayIncrementProgressCounter(uint64_t bitfield) : Base(bitfield) {}
+
+  static constexpr OpProperties kProperties = OpProperties::Writing() |
+                                              OpProperties::DeferredCall() |
+                                              OpProperties::LazyDeopt();
+
+  Input& closure() { return Node::input(0); }
+
+  DECL_NODE_INTERFACE_WITH_EMPTY_PRINT_PARAMS()
+};
+
 class ReplayIncrementAndCheckJsFrameDepth
     : public FixedInputNodeT<0, ReplayIncrementAndCheckJsFrameDepth> {
   using Base = FixedInputNodeT<0, ReplayIncrementAndCheckJsFrameDepth>;
@@ -3716,6 +3737,53 @@ class ReplayDecrementJsFrameDepth : public FixedInputNodeT<0, ReplayDecrementJsF
   DECL_NODE_INTERFACE_WITH_EMPTY_PRINT_PARAMS()
 };
 
+// Calls into the runtime for an instrumentation site when instrumentation
+// is enabled everywhere or for the closure's function, and does nothing
+// otherwise.
+class ReplayInstrumentation
+    : public FixedInputNodeT<1, ReplayInstrumentation> {
+  using Base = FixedInputNodeT<1, ReplayInstrumentation>;
+
+ public:
+  explicit ReplayInstrumentation(uint64_t bitfield, int index)
+      : Base(bitfield), index_(index) {}
+
+  static constexpr OpProperties kProperties = OpProperties::Writing() |
+                                              OpProperties::DeferredCall() |
+                                              OpProperties::LazyDeopt();
+
+  Input& closure() { return Node::input(0); }
+  int index() const { return index_; }
+
+  DECL_NODE_INTERFACE()
+
+ private:
+  const int index_;
+};
+
+// Same as ReplayInstrumentation, for sites where the function returns.
+class ReplayInstrumentationReturn
+    : public FixedInputNodeT<2, ReplayInstrumentationReturn> {
+  using Base = FixedInputNodeT<2, ReplayInstrumentationReturn>;
+
+ public:
+  explicit ReplayInstrumentationReturn(uint64_t bitfield, int index)
+      : Base(bitfield), index_(index) {}
+
+  static constexpr OpProperties kProperties = OpProperties::Writing() |
+                                              OpProperties::DeferredCall() |
+                                              OpProperties::LazyDeopt();
+
+  Input& closure() { return Node::input(0); }
+  Input& return_value() { return Node::input(1); }
+  int index() const { return index_; }
+
+  DECL_NODE_INTERFACE()
+
+ private:
+  const int index_;
+};
+
 class ThrowReferenceErrorIfHole
     : public FixedInputNodeT<1, ThrowReferenceErrorIfHole> {
   using Base = FixedInputNodeT<1, ThrowReferenceErrorIfHole>;
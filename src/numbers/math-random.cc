@@ -10,6 +10,7 @@
 #include "src/objects/contexts-inl.h"
 #include "src/objects/fixed-array.h"
 #include "src/objects/smi.h"
+#include "src/replay/replayio.h"
 
 namespace v8 {
 namespace internal {
@@ -57,17 +58,26 @@ Address MathRandom::RefillCache(Isolate* isolate, Address raw_native_context) {
   FixedDoubleArray cache =
       FixedDoubleArray::cast(native_context.math_random_cache());
   // Create random numbers.
-  for (int i = 0; i < kCacheSize; i++) {
-    // Generate random numbers using xorshift128+.
-    base::RandomNumberGenerator::XorShift128(&state.s0, &state.s1);
-    double v = base::RandomNumberGenerator::ToDouble(state.s0);
-
+  if (recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kValues,
+                                            "MathRandom")) {
     // The RNG can be used at non-deterministic points within the VM,
     // so we ensure that we're getting the same values whenever refilling
     // the cache used for Math.random().
-    recordreplay::RecordReplayBytes("MathRandom", &v, sizeof(v));
-
-    cache.set(i, v);
+    replayio::RecordReplayBatch batch("MathRandom");
+    for (int i = 0; i < kCacheSize; i++) {
+      base::RandomNumberGenerator::XorShift128(&state.s0, &state.s1);
+      batch.Add(base::RandomNumberGenerator::ToDouble(state.s0));
+    }
+    batch.Flush();
+    for (int i = 0; i < kCacheSize; i++) {
+      cache.set(i, batch.Get<double>(i));
+    }
+  } else {
+    for (int i = 0; i < kCacheSize; i++) {
+      // Generate random numbers using xorshift128+.
+      base::RandomNumberGenerator::XorShift128(&state.s0, &state.s1);
+      cache.set(i, base::RandomNumberGenerator::ToDouble(state.s0));
+    }
   }
   pod.set(0, state);
 
@@ -270,6 +270,9 @@ BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, maglev_compilation_failed,
 BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, sparkplug_compiled,
                     SharedFunctionInfo::SparkplugCompiledBit)
 
+BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, record_replay_instrumented,
+                    SharedFunctionInfo::RecordReplayInstrumentedBit)
+
 BIT_FIELD_ACCESSORS(SharedFunctionInfo, relaxed_flags, syntax_kind,
                     SharedFunctionInfo::FunctionSyntaxKindBits)
 
@@ -20,6 +20,7 @@
 #include "src/handles/maybe-handles-inl.h"
 #include "src/handles/shared-object-conveyor-handles.h"
 #include "src/heap/factory.h"
+#include "src/numbers/conversions-inl.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/heap-number-inl.h"
 #include "src/objects/js-array-buffer-inl.h"
@@ -38,6 +39,7 @@
 #include "src/objects/smi.h"
 #include "src/objects/transitions-inl.h"
 #include "src/snapshot/code-serializer.h"
+#include "src/utils/memcopy.h"
 
 #if V8_ENABLE_WEBASSEMBLY
 #include "src/wasm/wasm-objects-inl.h"
@@ -262,6 +264,10 @@ ValueSerializer::ValueSerializer(Isolate* isolate,
                                  v8::ValueSerializer::Delegate* delegate)
     : isolate_(isolate),
       delegate_(delegate),
+      canonical_numbers_(recordreplay::IsRecordingOrReplaying(
+          recordreplay::Feature::kValueSerializer)),
+      canonical_strings_(recordreplay::IsRecordingOrReplaying(
+          recordreplay::Feature::kValues, "ValueSerializer::WriteString")),
       zone_(isolate->allocator(), ZONE_NAME),
       id_map_(isolate->heap(), ZoneAllocationPolicy(&zone_)),
       array_buffer_transfer_map_(isolate->heap(),
@@ -286,6 +292,11 @@ void ValueSerializer::SetTreatArrayBufferViewsAsHostObjects(bool mode) {
   treat_array_buffer_views_as_host_objects_ = mode;
 }
 
+void ValueSerializer::SetCanonicalEncodingForTesting() {
+  canonical_numbers_ = true;
+  canonical_strings_ = true;
+}
+
 void ValueSerializer::WriteTag(SerializationTag tag) {
   uint8_t raw_tag = static_cast<uint8_t>(tag);
   WriteRawBytes(&raw_tag, sizeof(raw_tag));
@@ -445,11 +456,9 @@ Maybe<bool> ValueSerializer::WriteObject(Handle<Object> object) {
   if (V8_UNLIKELY(out_of_memory_)) return ThrowIfOutOfMemory();
 
   if (object->IsSmi()) {
-    if (recordreplay::IsRecordingOrReplaying("ValueSerializer")) {
+    if (canonical_numbers_) {
       // [TT-1403] Boxed numbers can be JIT'ed into SMIs.
-      // → Never take the optimized path to avoid divergence instead.
-      WriteTag(SerializationTag::kDouble);
-      WriteDouble(Smi::cast(*object).value());
+      WriteCanonicalNumber(Smi::cast(*object).value());
       return ThrowIfOutOfMemory();
     }
     WriteSmi(Smi::cast(*object));
@@ -526,10 +535,26 @@ void ValueSerializer::WriteSmi(Smi smi) {
 }
 
 void ValueSerializer::WriteHeapNumber(HeapNumber number) {
+  if (canonical_numbers_) {
+    WriteCanonicalNumber(number.value());
+    return;
+  }
   WriteTag(SerializationTag::kDouble);
   WriteDouble(number.value());
 }
 
+void ValueSerializer::WriteCanonicalNumber(double value) {
+  // Numbers which fit in an int32 are written as such whether they are Smis
+  // or heap numbers. This doesn't depend on the Smi range either.
+  if (IsInt32Double(value)) {
+    WriteTag(SerializationTag::kInt32);
+    WriteZigZag<int32_t>(FastD2I(value));
+  } else {
+    WriteTag(SerializationTag::kDouble);
+    WriteDouble(value);
+  }
+}
+
 void ValueSerializer::WriteBigInt(BigInt bigint) {
   WriteTag(SerializationTag::kBigInt);
   WriteBigIntContents(bigint);
@@ -542,26 +567,26 @@ void ValueSerializer::WriteString(Handle<String> string) {
   DCHECK(flat.IsFlat());
   if (flat.IsOneByte()) {
     base::Vector<const uint8_t> chars = flat.ToOneByteVector();
+    WriteTag(SerializationTag::kOneByteString);
+    WriteOneByteString(chars);
+  } else if (flat.IsTwoByte()) {
+    base::Vector<const base::uc16> chars = flat.ToUC16Vector();
 
     // Whether a string has a one or two byte representation can vary when
-    // replaying due to JIT and other VM behavior. Only write out strings
-    // as two bytes to ensure serialized buffers have a consistent size.
-    if (recordreplay::IsRecordingOrReplaying("values", "ValueSerializer::WriteString")) {
-      base::ScopedVector<base::uc16> new_chars(chars.length());
-      for (int i = 0; i < chars.length(); i++)
-        new_chars[i] = chars[i];
-      uint32_t byte_length = new_chars.length() * sizeof(base::uc16);
-      // The existing reading code expects 16-byte strings to be aligned.
-      if ((buffer_size_ + 1 + BytesNeededForVarint(byte_length)) & 1)
-        WriteTag(SerializationTag::kPadding);
-      WriteTag(SerializationTag::kTwoByteString);
-      WriteTwoByteString(new_chars);
-    } else {
+    // replaying due to JIT and other VM behavior. Strings whose contents fit
+    // in one byte are always written as one byte strings so that serialized
+    // buffers are consistent.
+    if (canonical_strings_ &&
+        String::IsOneByte(chars.begin(), chars.length())) {
       WriteTag(SerializationTag::kOneByteString);
-      WriteOneByteString(chars);
+      WriteVarint<uint32_t>(chars.length());
+      uint8_t* dest;
+      if (ReserveRawBytes(chars.length()).To(&dest)) {
+        CopyChars(dest, chars.begin(), chars.length());
+      }
+      return;
     }
-  } else if (flat.IsTwoByte()) {
-    base::Vector<const base::uc16> chars = flat.ToUC16Vector();
+
     uint32_t byte_length = chars.length() * sizeof(base::uc16);
     // The existing reading code expects 16-byte strings to be aligned.
     if ((buffer_size_ + 1 + BytesNeededForVarint(byte_length)) & 1)
@@ -670,7 +695,7 @@ Maybe<bool> ValueSerializer::WriteJSObject(Handle<JSObject> object) {
   DCHECK(!object->map().IsCustomElementsReceiverMap());
   const bool can_serialize_fast =
     // [TT-492] Slow path all serialization so we're guaranteed to always match.
-    !recordreplay::IsRecordingOrReplaying("ValueSerializer") &&
+    !recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kValueSerializer) &&
       object->HasFastProperties(isolate_) && object->elements().length() == 0;
 
   if (!can_serialize_fast) return WriteJSObjectSlow(object);
@@ -747,7 +772,8 @@ Maybe<bool> ValueSerializer::WriteJSArray(Handle<JSArray> array) {
 
   const bool should_serialize_densely =
     // [TT-492] Slow-path all serialization to avoid JIT- or GC-related divergences.
-    !recordreplay::IsRecordingOrReplaying("values", "ValueSerializer::WriteJSArray") &&
+    !recordreplay::IsRecordingOrReplaying(recordreplay::Feature::kValues,
+                                          "ValueSerializer::WriteJSArray") &&
     array->HasFastElements(cage_base) && !array->HasHoleyElements(cage_base);
 
   if (should_serialize_densely) {
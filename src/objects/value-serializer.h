@@ -97,6 +97,12 @@ class ValueSerializer {
    */
   void SetTreatArrayBufferViewsAsHostObjects(bool mode);
 
+  /*
+   * Write numbers and strings in the canonical encoding used when recording
+   * or replaying.
+   */
+  void SetCanonicalEncodingForTesting();
+
  private:
   friend class WebSnapshotSerializer;
 
@@ -118,6 +124,8 @@ class ValueSerializer {
   void WriteOddball(Oddball oddball);
   void WriteSmi(Smi smi);
   void WriteHeapNumber(HeapNumber number);
+  // Write a number in the canonical encoding, which only depends on its value.
+  void WriteCanonicalNumber(double value);
   void WriteBigInt(BigInt bigint);
   void WriteString(Handle<String> string);
   Maybe<bool> WriteJSReceiver(Handle<JSReceiver> receiver)
@@ -176,6 +184,11 @@ class ValueSerializer {
   size_t buffer_capacity_ = 0;
   bool treat_array_buffer_views_as_host_objects_ = false;
   bool out_of_memory_ = false;
+  // Whether numbers and strings are written in an encoding which doesn't
+  // depend on their representation in the heap, which can differ when
+  // replaying.
+  bool canonical_numbers_;
+  bool canonical_strings_;
   Zone zone_;
 
   // To avoid extra lookups in the identity map, ID+1 is actually stored in the
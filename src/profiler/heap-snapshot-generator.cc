@@ -6,15 +6,20 @@
 
 #include <utility>
 
+#include "include/v8-platform.h"
 #include "src/api/api-inl.h"
 #include "src/base/optional.h"
 #include "src/base/vector.h"
 #include "src/codegen/assembler-inl.h"
+#include "src/common/code-memory-access.h"
 #include "src/common/globals.h"
 #include "src/debug/debug.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/combined-heap.h"
+#include "src/heap/index-generator.h"
+#include "src/heap/parallel-work-item.h"
 #include "src/heap/safepoint.h"
+#include "src/init/v8.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/api-callbacks.h"
@@ -772,6 +777,12 @@ HeapEntry* V8HeapExplorer::AllocateEntry(Smi smi) {
 }
 
 void V8HeapExplorer::ExtractLocation(HeapEntry* entry, HeapObject object) {
+  if (deferred_references_ != nullptr) {
+    // Finding the constructor requires handles, so this is done on the main
+    // thread.
+    deferred_references_->emplace_back(DeferredReference::kLocation, object);
+    return;
+  }
   if (object.IsJSFunction()) {
     JSFunction func = JSFunction::cast(object);
     ExtractLocationForJSFunction(entry, func);
@@ -1964,6 +1975,7 @@ String V8HeapExplorer::GetConstructorName(Isolate* isolate, JSObject object) {
 }
 
 HeapEntry* V8HeapExplorer::GetEntry(Object obj) {
+  DCHECK_NULL(deferred_references_);
   if (obj.IsHeapObject()) {
     return generator_->FindOrAddEntry(reinterpret_cast<void*>(obj.ptr()), this);
   }
@@ -2075,54 +2087,248 @@ bool V8HeapExplorer::IterateAndExtractReferences(
 
   CombinedHeapObjectIterator iterator(heap_,
                                       HeapObjectIterator::kFilterUnreachable);
-  PtrComprCageBase cage_base(heap_->isolate());
-  // Heap iteration with filtering must be finished in any case.
-  for (HeapObject obj = iterator.Next(); !obj.is_null();
-       obj = iterator.Next(), progress_->ProgressStep()) {
-    if (interrupted) continue;
+  int num_tasks = NumberOfReferenceExtractionTasks();
+  if (num_tasks > 1) {
+    interrupted = !IterateAndExtractReferencesInParallel(&iterator, num_tasks);
+  } else {
+    // Heap iteration with filtering must be finished in any case.
+    for (HeapObject obj = iterator.Next(); !obj.is_null();
+         obj = iterator.Next(), progress_->ProgressStep()) {
+      if (interrupted) continue;
 
-    size_t max_pointer = obj.Size(cage_base) / kTaggedSize;
-    if (max_pointer > visited_fields_.size()) {
-      // Clear the current bits.
-      std::vector<bool>().swap(visited_fields_);
-      // Reallocate to right size.
-      visited_fields_.resize(max_pointer, false);
+#ifdef V8_ENABLE_HEAP_SNAPSHOT_VERIFY
+      std::unique_ptr<HeapEntryVerifier> verifier;
+      // MarkingVisitorBase doesn't expect that we will ever visit read-only
+      // objects, and fails DCHECKs if we attempt to. Read-only objects can
+      // never retain read-write objects, so there is no risk in skipping
+      // verification for them.
+      if (v8_flags.heap_snapshot_verify &&
+          !BasicMemoryChunk::FromHeapObject(obj)->InReadOnlySpace()) {
+        verifier = std::make_unique<HeapEntryVerifier>(generator, obj);
+      }
+#endif
+
+      HeapEntry* entry = GetEntry(obj);
+      ExtractObjectReferences(entry, obj);
+
+      if (!progress_->ProgressReport(false)) interrupted = true;
     }
+  }
 
-#ifdef V8_ENABLE_HEAP_SNAPSHOT_VERIFY
-    std::unique_ptr<HeapEntryVerifier> verifier;
-    // MarkingVisitorBase doesn't expect that we will ever visit read-only
-    // objects, and fails DCHECKs if we attempt to. Read-only objects can
-    // never retain read-write objects, so there is no risk in skipping
-    // verification for them.
-    if (v8_flags.heap_snapshot_verify &&
-        !BasicMemoryChunk::FromHeapObject(obj)->InReadOnlySpace()) {
-      verifier = std::make_unique<HeapEntryVerifier>(generator, obj);
+  generator_ = nullptr;
+  return interrupted ? false : progress_->ProgressReport(true);
+}
+
+void V8HeapExplorer::ExtractObjectReferences(HeapEntry* entry,
+                                             HeapObject obj) {
+  PtrComprCageBase cage_base(isolate());
+  size_t max_pointer = obj.Size(cage_base) / kTaggedSize;
+  if (max_pointer > visited_fields_.size()) {
+    // Clear the current bits.
+    std::vector<bool>().swap(visited_fields_);
+    // Reallocate to right size.
+    visited_fields_.resize(max_pointer, false);
+  }
+
+  ExtractReferences(entry, obj);
+  SetInternalReference(entry, "map", obj.map(cage_base),
+                       HeapObject::kMapOffset);
+  // Extract unvisited fields as hidden references and restore tags
+  // of visited fields.
+  IndexedReferencesExtractor refs_extractor(this, obj, entry);
+  obj.Iterate(cage_base, &refs_extractor);
+
+  // Ensure visited_fields_ doesn't leak to the next object.
+  for (size_t i = 0; i < max_pointer; ++i) {
+    DCHECK(!visited_fields_[i]);
+  }
+
+  // Extract location for specific object types
+  ExtractLocation(entry, obj);
+}
+
+// Extracts references from batches of heap objects on worker threads. Each
+// task uses its own V8HeapExplorer, which records the changes to make to the
+// snapshot in the batch instead of making them.
+class ReferencesExtractionJob : public v8::JobTask {
+ public:
+  struct Batch {
+    std::vector<HeapObject> objects;
+    std::vector<V8HeapExplorer::DeferredReference> references;
+  };
+
+  ReferencesExtractionJob(
+      std::vector<std::unique_ptr<V8HeapExplorer>>* explorers,
+      std::vector<std::pair<ParallelWorkItem, Batch>>* batches)
+      : explorers_(explorers),
+        batches_(batches),
+        remaining_batches_(batches->size()),
+        generator_(batches->size()) {}
+
+  ReferencesExtractionJob(const ReferencesExtractionJob&) = delete;
+  ReferencesExtractionJob& operator=(const ReferencesExtractionJob&) = delete;
+
+  void Run(JobDelegate* delegate) override {
+    // The task accesses code pages and thus the permissions must be set to
+    // default state.
+    RwxMemoryWriteScope::SetDefaultPermissionsForNewThread();
+    DCHECK_LT(delegate->GetTaskId(), explorers_->size());
+    V8HeapExplorer* explorer = (*explorers_)[delegate->GetTaskId()].get();
+    while (remaining_batches_.load(std::memory_order_relaxed) > 0) {
+      base::Optional<size_t> index = generator_.GetNext();
+      if (!index) return;
+      for (size_t i = *index; i < batches_->size(); ++i) {
+        auto& work_item = (*batches_)[i];
+        if (!work_item.first.TryAcquire()) break;
+        explorer->DeferReferences(work_item.second.objects,
+                                  &work_item.second.references);
+        if (remaining_batches_.fetch_sub(1, std::memory_order_relaxed) <= 1) {
+          return;
+        }
+      }
     }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    return std::min<size_t>(explorers_->size(),
+                            remaining_batches_.load(std::memory_order_relaxed));
+  }
+
+ private:
+  std::vector<std::unique_ptr<V8HeapExplorer>>* explorers_;
+  std::vector<std::pair<ParallelWorkItem, Batch>>* batches_;
+  std::atomic<size_t> remaining_batches_;
+  IndexGenerator generator_;
+};
+
+int V8HeapExplorer::NumberOfReferenceExtractionTasks() {
+  if (!v8_flags.parallel_heap_snapshot) return 1;
+#ifdef V8_ENABLE_HEAP_SNAPSHOT_VERIFY
+  // The verifier checks references as they are added, one object at a time.
+  if (v8_flags.heap_snapshot_verify) return 1;
 #endif
+  static const int kMaxReferenceExtractionTasks = 16;
+  int num_cores = V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1;
+  return std::min(num_cores, kMaxReferenceExtractionTasks);
+}
 
-    HeapEntry* entry = GetEntry(obj);
-    ExtractReferences(entry, obj);
-    SetInternalReference(entry, "map", obj.map(cage_base),
-                         HeapObject::kMapOffset);
-    // Extract unvisited fields as hidden references and restore tags
-    // of visited fields.
-    IndexedReferencesExtractor refs_extractor(this, obj, entry);
-    obj.Iterate(cage_base, &refs_extractor);
+bool V8HeapExplorer::IterateAndExtractReferencesInParallel(
+    CombinedHeapObjectIterator* iterator, int num_tasks) {
+  static const size_t kObjectsPerBatch = 1024;
+  static const size_t kBatchesPerTask = 16;
+
+  std::vector<std::unique_ptr<V8HeapExplorer>> explorers;
+  for (int i = 0; i < num_tasks; ++i) {
+    explorers.push_back(
+        std::make_unique<V8HeapExplorer>(snapshot_, progress_, nullptr));
+    explorers.back()->generator_ = generator_;
+  }
+
+  // Objects are found on the main thread, as the iterator filters out
+  // unreachable objects. The iterator is drained in chunks which are split
+  // into batches for the workers, and the references they find are added to
+  // the snapshot in iteration order afterwards. This produces the same
+  // snapshot as extracting references on the main thread.
+  bool interrupted = false;
+  std::vector<std::pair<ParallelWorkItem, ReferencesExtractionJob::Batch>>
+      batches;
+  HeapObject obj = iterator->Next();
+  while (!obj.is_null()) {
+    batches.clear();
+    while (!obj.is_null() && batches.size() < kBatchesPerTask * num_tasks) {
+      batches.emplace_back();
+      std::vector<HeapObject>& objects = batches.back().second.objects;
+      objects.reserve(kObjectsPerBatch);
+      while (!obj.is_null() && objects.size() < kObjectsPerBatch) {
+        objects.push_back(obj);
+        obj = iterator->Next();
+      }
+    }
+    // Heap iteration with filtering must be finished in any case.
+    if (interrupted) continue;
 
-    // Ensure visited_fields_ doesn't leak to the next object.
-    for (size_t i = 0; i < max_pointer; ++i) {
-      DCHECK(!visited_fields_[i]);
+    V8::GetCurrentPlatform()
+        ->CreateJob(v8::TaskPriority::kUserBlocking,
+                    std::make_unique<ReferencesExtractionJob>(&explorers,
+                                                              &batches))
+        ->Join();
+
+    for (auto& work_item : batches) {
+      ReferencesExtractionJob::Batch& batch = work_item.second;
+      AddDeferredReferences(batch.references);
+      // Progress is reported for each object as in the serial loop, as
+      // ProgressReport only reports when the counter is a multiple of its
+      // granularity.
+      for (size_t i = 0; i < batch.objects.size() && !interrupted; ++i) {
+        progress_->ProgressStep();
+        if (!progress_->ProgressReport(false)) interrupted = true;
+      }
+      if (interrupted) break;
     }
+  }
+  return !interrupted;
+}
 
-    // Extract location for specific object types
-    ExtractLocation(entry, obj);
+bool V8HeapExplorer::ExtractsReferencesOnMainThread(HeapObject obj) {
+  // These objects' references are added by creating or reading entries
+  // directly.
+  if (obj.IsJSArrayBuffer() || obj.IsEphemeronHashTable()) return true;
+  if (obj.IsHeapNumber()) return snapshot_->capture_numeric_value();
+  // Iterating swiss dictionaries creates handles.
+  return V8_ENABLE_SWISS_NAME_DICTIONARY_BOOL && obj.IsJSObject() &&
+         !JSObject::cast(obj).HasFastProperties();
+}
 
-    if (!progress_->ProgressReport(false)) interrupted = true;
+void V8HeapExplorer::DeferReferences(
+    const std::vector<HeapObject>& objects,
+    std::vector<DeferredReference>* references) {
+  DCHECK_NULL(deferred_references_);
+  deferred_references_ = references;
+  for (HeapObject obj : objects) {
+    if (ExtractsReferencesOnMainThread(obj)) {
+      references->emplace_back(DeferredReference::kSerialObject, obj);
+      continue;
+    }
+    references->emplace_back(DeferredReference::kObject, obj);
+    ExtractObjectReferences(nullptr, obj);
   }
+  deferred_references_ = nullptr;
+}
 
-  generator_ = nullptr;
-  return interrupted ? false : progress_->ProgressReport(true);
+void V8HeapExplorer::AddDeferredReferences(
+    const std::vector<DeferredReference>& references) {
+  DCHECK_NULL(deferred_references_);
+  HeapEntry* entry = nullptr;
+  for (const DeferredReference& reference : references) {
+    switch (reference.kind) {
+      case DeferredReference::kObject:
+        entry = GetEntry(reference.object);
+        break;
+      case DeferredReference::kSerialObject: {
+        HeapObject obj = HeapObject::cast(reference.object);
+        ExtractObjectReferences(GetEntry(obj), obj);
+        entry = nullptr;
+        break;
+      }
+      case DeferredReference::kEntry:
+        GetEntry(reference.object);
+        break;
+      case DeferredReference::kNamed:
+        SetNamedEdge(entry, reference.edge_type, reference.name,
+                     reference.object, reference.verification);
+        break;
+      case DeferredReference::kIndexed:
+        SetIndexedEdge(entry, reference.edge_type, reference.index,
+                       reference.object);
+        break;
+      case DeferredReference::kTag:
+        TagObject(reference.object, reference.name, reference.entry_type);
+        break;
+      case DeferredReference::kLocation:
+        ExtractLocation(entry, HeapObject::cast(reference.object));
+        break;
+    }
+  }
 }
 
 bool V8HeapExplorer::IsEssentialObject(Object object) {
@@ -2166,14 +2372,51 @@ bool V8HeapExplorer::IsEssentialHiddenReference(Object parent,
 void V8HeapExplorer::SetContextReference(HeapEntry* parent_entry,
                                          String reference_name,
                                          Object child_obj, int field_offset) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
-  parent_entry->SetNamedReference(HeapGraphEdge::kContextVariable,
-                                  names_->GetName(reference_name), child_entry,
-                                  generator_);
+  if (!HasEntry(child_obj)) return;
+  SetNamedEdge(parent_entry, HeapGraphEdge::kContextVariable,
+               names_->GetName(reference_name), child_obj);
   MarkVisitedField(field_offset);
 }
 
+bool V8HeapExplorer::HasEntry(Object obj) {
+  // Matches the cases where GetEntry returns nullptr.
+  return obj.IsHeapObject() || snapshot_->capture_numeric_value();
+}
+
+void V8HeapExplorer::SetNamedEdge(
+    HeapEntry* parent_entry, HeapGraphEdge::Type type, const char* name,
+    Object child_obj, HeapEntry::ReferenceVerification verification) {
+  if (deferred_references_ != nullptr) {
+    DeferredReference& reference =
+        deferred_references_->emplace_back(DeferredReference::kNamed,
+                                           child_obj);
+    reference.edge_type = type;
+    reference.name = name;
+    reference.verification = verification;
+    return;
+  }
+  HeapEntry* child_entry = GetEntry(child_obj);
+  DCHECK_NOT_NULL(child_entry);
+  parent_entry->SetNamedReference(type, name, child_entry, generator_,
+                                  verification);
+}
+
+void V8HeapExplorer::SetIndexedEdge(HeapEntry* parent_entry,
+                                    HeapGraphEdge::Type type, int index,
+                                    Object child_obj) {
+  if (deferred_references_ != nullptr) {
+    DeferredReference& reference =
+        deferred_references_->emplace_back(DeferredReference::kIndexed,
+                                           child_obj);
+    reference.edge_type = type;
+    reference.index = index;
+    return;
+  }
+  HeapEntry* child_entry = GetEntry(child_obj);
+  DCHECK_NOT_NULL(child_entry);
+  parent_entry->SetIndexedReference(type, index, child_entry, generator_);
+}
+
 void V8HeapExplorer::MarkVisitedField(int offset) {
   if (offset < 0) return;
   int index = offset / kTaggedSize;
@@ -2184,18 +2427,15 @@ void V8HeapExplorer::MarkVisitedField(int offset) {
 void V8HeapExplorer::SetNativeBindReference(HeapEntry* parent_entry,
                                             const char* reference_name,
                                             Object child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
-  parent_entry->SetNamedReference(HeapGraphEdge::kShortcut, reference_name,
-                                  child_entry, generator_);
+  if (!HasEntry(child_obj)) return;
+  SetNamedEdge(parent_entry, HeapGraphEdge::kShortcut, reference_name,
+               child_obj);
 }
 
 void V8HeapExplorer::SetElementReference(HeapEntry* parent_entry, int index,
                                          Object child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
-  parent_entry->SetIndexedReference(HeapGraphEdge::kElement, index, child_entry,
-                                    generator_);
+  if (!HasEntry(child_obj)) return;
+  SetIndexedEdge(parent_entry, HeapGraphEdge::kElement, index, child_obj);
 }
 
 void V8HeapExplorer::SetInternalReference(HeapEntry* parent_entry,
@@ -2204,10 +2444,8 @@ void V8HeapExplorer::SetInternalReference(HeapEntry* parent_entry,
   if (!IsEssentialObject(child_obj)) {
     return;
   }
-  HeapEntry* child_entry = GetEntry(child_obj);
-  DCHECK_NOT_NULL(child_entry);
-  parent_entry->SetNamedReference(HeapGraphEdge::kInternal, reference_name,
-                                  child_entry, generator_);
+  SetNamedEdge(parent_entry, HeapGraphEdge::kInternal, reference_name,
+               child_obj);
   MarkVisitedField(field_offset);
 }
 
@@ -2216,27 +2454,26 @@ void V8HeapExplorer::SetInternalReference(HeapEntry* parent_entry, int index,
   if (!IsEssentialObject(child_obj)) {
     return;
   }
-  HeapEntry* child_entry = GetEntry(child_obj);
-  DCHECK_NOT_NULL(child_entry);
-  parent_entry->SetNamedReference(HeapGraphEdge::kInternal,
-                                  names_->GetName(index), child_entry,
-                                  generator_);
+  SetNamedEdge(parent_entry, HeapGraphEdge::kInternal, names_->GetName(index),
+               child_obj);
   MarkVisitedField(field_offset);
 }
 
 void V8HeapExplorer::SetHiddenReference(HeapObject parent_obj,
                                         HeapEntry* parent_entry, int index,
                                         Object child_obj, int field_offset) {
-  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  DCHECK_IMPLIES(deferred_references_ == nullptr,
+                 parent_entry == GetEntry(parent_obj));
   DCHECK(!MapWord::IsPacked(child_obj.ptr()));
   if (!IsEssentialObject(child_obj)) {
     return;
   }
-  HeapEntry* child_entry = GetEntry(child_obj);
-  DCHECK_NOT_NULL(child_entry);
   if (IsEssentialHiddenReference(parent_obj, field_offset)) {
-    parent_entry->SetIndexedReference(HeapGraphEdge::kHidden, index,
-                                      child_entry, generator_);
+    SetIndexedEdge(parent_entry, HeapGraphEdge::kHidden, index, child_obj);
+  } else if (deferred_references_ != nullptr) {
+    deferred_references_->emplace_back(DeferredReference::kEntry, child_obj);
+  } else {
+    GetEntry(child_obj);
   }
 }
 
@@ -2246,10 +2483,8 @@ void V8HeapExplorer::SetWeakReference(
   if (!IsEssentialObject(child_obj)) {
     return;
   }
-  HeapEntry* child_entry = GetEntry(child_obj);
-  DCHECK_NOT_NULL(child_entry);
-  parent_entry->SetNamedReference(HeapGraphEdge::kWeak, reference_name,
-                                  child_entry, generator_, verification);
+  SetNamedEdge(parent_entry, HeapGraphEdge::kWeak, reference_name, child_obj,
+               verification);
   MarkVisitedField(field_offset);
 }
 
@@ -2259,11 +2494,8 @@ void V8HeapExplorer::SetWeakReference(HeapEntry* parent_entry, int index,
   if (!IsEssentialObject(child_obj)) {
     return;
   }
-  HeapEntry* child_entry = GetEntry(child_obj);
-  DCHECK_NOT_NULL(child_entry);
-  parent_entry->SetNamedReference(HeapGraphEdge::kWeak,
-                                  names_->GetFormatted("%d", index),
-                                  child_entry, generator_);
+  SetNamedEdge(parent_entry, HeapGraphEdge::kWeak,
+               names_->GetFormatted("%d", index), child_obj);
   if (field_offset.has_value()) {
     MarkVisitedField(*field_offset);
   }
@@ -2285,8 +2517,7 @@ void V8HeapExplorer::SetPropertyReference(HeapEntry* parent_entry,
                                           Name reference_name, Object child_obj,
                                           const char* name_format_string,
                                           int field_offset) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  if (!HasEntry(child_obj)) return;
   HeapGraphEdge::Type type =
       reference_name.IsSymbol() || String::cast(reference_name).length() > 0
           ? HeapGraphEdge::kProperty
@@ -2300,7 +2531,7 @@ void V8HeapExplorer::SetPropertyReference(HeapEntry* parent_entry,
                     .get())
           : names_->GetName(reference_name);
 
-  parent_entry->SetNamedReference(type, name, child_entry, generator_);
+  SetNamedEdge(parent_entry, type, name, child_obj);
   MarkVisitedField(field_offset);
 }
 
@@ -2377,6 +2608,13 @@ const char* V8HeapExplorer::GetStrongGcSubrootName(Object object) {
 void V8HeapExplorer::TagObject(Object obj, const char* tag,
                                base::Optional<HeapEntry::Type> type) {
   if (IsEssentialObject(obj)) {
+    if (deferred_references_ != nullptr) {
+      DeferredReference& reference =
+          deferred_references_->emplace_back(DeferredReference::kTag, obj);
+      reference.name = tag;
+      reference.entry_type = type;
+      return;
+    }
     HeapEntry* entry = GetEntry(obj);
     if (entry->name()[0] == '\0') {
       entry->set_name(tag);
@@ -2839,6 +3077,34 @@ class OutputStreamWriter {
     }
   }
   void AddNumber(unsigned n) { AddNumberImpl<unsigned>(n, "%u"); }
+  // Unlike the methods above, these can add '\0' and are used for the binary
+  // format.
+  void AddByte(uint8_t b) {
+    DCHECK(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = static_cast<char>(b);
+    MaybeWriteChunk();
+  }
+  void AddVarint(uint64_t n) {
+    // Unsigned LEB128.
+    while (n >= 0x80) {
+      AddByte(static_cast<uint8_t>(n | 0x80));
+      n >>= 7;
+    }
+    AddByte(static_cast<uint8_t>(n));
+  }
+  void AddBytes(const char* s, size_t n) {
+    const char* s_end = s + n;
+    while (s < s_end) {
+      size_t available = static_cast<size_t>(chunk_size_ - chunk_pos_);
+      int s_chunk_size = static_cast<int>(
+          std::min(available, static_cast<size_t>(s_end - s)));
+      DCHECK_GT(s_chunk_size, 0);
+      MemCopy(chunk_.begin() + chunk_pos_, s, s_chunk_size);
+      s += s_chunk_size;
+      chunk_pos_ += s_chunk_size;
+      MaybeWriteChunk();
+    }
+  }
   void Finalize() {
     if (aborted_) return;
     DCHECK(chunk_pos_ < chunk_size_);
@@ -2894,6 +3160,7 @@ class OutputStreamWriter {
 const int HeapSnapshotJSONSerializer::kEdgeFieldsCount = 3;
 // type, name, id, self_size, edge_count, trace_node_id, detachedness.
 const int HeapSnapshotJSONSerializer::kNodeFieldsCount = 7;
+const int HeapSnapshotJSONSerializer::kBinaryFormatVersion = 1;
 
 void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
   if (AllocationTracker* allocation_tracker =
@@ -2907,15 +3174,38 @@ void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
   writer_ = nullptr;
 }
 
+void HeapSnapshotJSONSerializer::SerializeBinary(v8::OutputStream* stream) {
+  if (AllocationTracker* allocation_tracker =
+      snapshot_->profiler()->allocation_tracker()) {
+    allocation_tracker->PrepareForSerialization();
+  }
+  DCHECK_NULL(writer_);
+  writer_ = new OutputStreamWriter(stream);
+  SerializeBinaryImpl();
+  delete writer_;
+  writer_ = nullptr;
+}
+
+// static
+bool HeapSnapshotJSONSerializer::IsSerializationDisabled() {
+  // Heap contents can vary when recording vs. replaying, and we don't want
+  // these variances to affect behavior when replaying. Snapshots are allowed
+  // while replaying with events disallowed, e.g. when paused in the debugger,
+  // as nothing done then affects the rest of the replay.
+  if (!recordreplay::IsRecordingOrReplaying(
+          recordreplay::Feature::kGCChanges)) {
+    return false;
+  }
+  return !recordreplay::IsReplaying() || !recordreplay::AreEventsDisallowed();
+}
+
 
 void HeapSnapshotJSONSerializer::SerializeImpl() {
   DCHECK_EQ(0, snapshot_->root()->index());
 
-  // Heap contents can vary when recording vs. replaying, and we don't want
-  // these variances to affect behavior when replaying. We could record/replay
-  // the snapshot itself, but it is simpler to just disable this functionality.
-  if (recordreplay::IsRecordingOrReplaying("gc-changes", "HeapSnapshotJSONSerializer::SerializeImpl")) {
+  if (IsSerializationDisabled()) {
     writer_->AddString("{}");
+    writer_->Finalize();
     return;
   }
 
@@ -3397,5 +3687,160 @@ void HeapSnapshotJSONSerializer::SerializeLocations() {
   }
 }
 
+void HeapSnapshotJSONSerializer::SerializeBinaryImpl() {
+  DCHECK_EQ(0, snapshot_->root()->index());
+
+  writer_->AddString("V8HS");
+  writer_->AddVarint(kBinaryFormatVersion);
+
+  // An empty snapshot object is written when snapshots are disabled, and is
+  // converted to the "{}" written by SerializeImpl.
+  if (IsSerializationDisabled()) {
+    writer_->AddByte(0);
+    writer_->Finalize();
+    return;
+  }
+
+  // The snapshot object is small and is kept in the same text form as for the
+  // JSON format, so that the converter doesn't need to know about its
+  // contents.
+  SerializeSnapshot();
+  writer_->AddByte(0);
+  if (writer_->aborted()) return;
+  SerializeBinaryNodes();
+  if (writer_->aborted()) return;
+  SerializeBinaryEdges();
+  if (writer_->aborted()) return;
+  SerializeBinaryTraceNodeInfos();
+  if (writer_->aborted()) return;
+  SerializeBinarySamples();
+  if (writer_->aborted()) return;
+  SerializeBinaryLocations();
+  if (writer_->aborted()) return;
+
+  AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
+  writer_->AddVarint(tracker ? 1 : 0);
+  if (tracker) {
+    SerializeBinaryTraceNode(tracker->trace_tree()->root());
+    if (writer_->aborted()) return;
+  }
+
+  // Strings are written last, after everything referring to them has been
+  // assigned an id.
+  SerializeBinaryStrings();
+  if (writer_->aborted()) return;
+  writer_->Finalize();
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinaryNodes() {
+  const std::deque<HeapEntry>& entries = snapshot_->entries();
+  writer_->AddVarint(entries.size());
+  for (const HeapEntry& entry : entries) {
+    writer_->AddVarint(entry.type());
+    writer_->AddVarint(GetStringId(entry.name()));
+    writer_->AddVarint(entry.id());
+    writer_->AddVarint(entry.self_size());
+    writer_->AddVarint(entry.children_count());
+    writer_->AddVarint(entry.trace_node_id());
+    writer_->AddVarint(entry.detachedness());
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinaryEdges() {
+  std::vector<HeapGraphEdge*>& edges = snapshot_->children();
+  writer_->AddVarint(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    DCHECK(i == 0 ||
+           edges[i - 1]->from()->index() <= edges[i]->from()->index());
+    HeapGraphEdge* edge = edges[i];
+    int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
+        || edge->type() == HeapGraphEdge::kHidden
+        ? edge->index() : GetStringId(edge->name());
+    writer_->AddVarint(edge->type());
+    writer_->AddVarint(static_cast<unsigned>(edge_name_or_index));
+    writer_->AddVarint(to_node_index(edge->to()));
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinaryTraceNode(
+    AllocationTraceNode* node) {
+  writer_->AddVarint(node->id());
+  writer_->AddVarint(node->function_info_index());
+  writer_->AddVarint(node->allocation_count());
+  writer_->AddVarint(node->allocation_size());
+  writer_->AddVarint(node->children().size());
+  for (AllocationTraceNode* child : node->children()) {
+    SerializeBinaryTraceNode(child);
+  }
+}
+
+// Positions are converted to 1-based as for SerializePosition.
+static uint64_t BinaryPosition(int position) {
+  DCHECK_GE(position, -1);
+  return position == -1 ? 0 : static_cast<uint64_t>(position) + 1;
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinaryTraceNodeInfos() {
+  AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
+  if (!tracker) {
+    writer_->AddVarint(0);
+    return;
+  }
+  writer_->AddVarint(tracker->function_info_list().size());
+  for (AllocationTracker::FunctionInfo* info : tracker->function_info_list()) {
+    writer_->AddVarint(info->function_id);
+    writer_->AddVarint(GetStringId(info->name));
+    writer_->AddVarint(GetStringId(info->script_name));
+    // The cast is safe because script id is a non-negative Smi.
+    writer_->AddVarint(static_cast<unsigned>(info->script_id));
+    writer_->AddVarint(BinaryPosition(info->line));
+    writer_->AddVarint(BinaryPosition(info->column));
+  }
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinarySamples() {
+  const std::vector<HeapObjectsMap::TimeInterval>& samples =
+      snapshot_->profiler()->heap_object_map()->samples();
+  writer_->AddVarint(samples.size());
+  if (samples.empty()) return;
+  base::TimeTicks start_time = samples[0].timestamp;
+  for (const HeapObjectsMap::TimeInterval& sample : samples) {
+    base::TimeDelta time_delta = sample.timestamp - start_time;
+    writer_->AddVarint(static_cast<uint64_t>(time_delta.InMicroseconds()));
+    writer_->AddVarint(sample.last_assigned_id());
+  }
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinaryLocations() {
+  const std::vector<SourceLocation>& locations = snapshot_->locations();
+  writer_->AddVarint(locations.size());
+  for (const SourceLocation& location : locations) {
+    writer_->AddVarint(to_node_index(location.entry_index));
+    writer_->AddVarint(static_cast<unsigned>(location.scriptId));
+    writer_->AddVarint(static_cast<unsigned>(location.line));
+    writer_->AddVarint(static_cast<unsigned>(location.col));
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotJSONSerializer::SerializeBinaryStrings() {
+  base::ScopedVector<const char*> sorted_strings(strings_.occupancy() + 1);
+  for (base::HashMap::Entry* entry = strings_.Start(); entry != nullptr;
+       entry = strings_.Next(entry)) {
+    int index = static_cast<int>(reinterpret_cast<uintptr_t>(entry->value));
+    sorted_strings[index] = reinterpret_cast<const char*>(entry->key);
+  }
+  sorted_strings[0] = "<dummy>";
+  writer_->AddVarint(sorted_strings.length());
+  for (int i = 0; i < sorted_strings.length(); ++i) {
+    size_t length = strlen(sorted_strings[i]);
+    writer_->AddVarint(length);
+    writer_->AddBytes(sorted_strings[i], length);
+    if (writer_->aborted()) return;
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
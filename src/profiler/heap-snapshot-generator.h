@@ -32,6 +32,7 @@ namespace v8 {
 namespace internal {
 
 class AllocationTraceNode;
+class CombinedHeapObjectIterator;
 class HeapEntry;
 class HeapProfiler;
 class HeapSnapshot;
@@ -43,6 +44,7 @@ class JSGlobalObject;
 class JSGlobalProxy;
 class JSPromise;
 class JSWeakCollection;
+class ReferencesExtractionJob;
 class SafepointScope;
 
 struct SourceLocation {
@@ -401,6 +403,32 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
   static String GetConstructorName(Isolate* isolate, JSObject object);
 
  private:
+  // An operation on the snapshot recorded by a worker thread while extracting
+  // references in parallel. These are applied on the main thread in the order
+  // they were recorded, so that entries and edges are added in the same order
+  // as when extracting references on the main thread.
+  struct DeferredReference {
+    enum Kind : uint8_t {
+      kObject,        // Following references are from |object|.
+      kSerialObject,  // Extract all references from |object|.
+      kEntry,         // Create the entry for |object|.
+      kNamed,         // Named edge to |object|.
+      kIndexed,       // Indexed edge to |object|.
+      kTag,           // Tag |object| with |name| and |entry_type|.
+      kLocation,      // Extract the location of |object|.
+    };
+
+    DeferredReference(Kind kind, Object object) : kind(kind), object(object) {}
+
+    Kind kind;
+    HeapGraphEdge::Type edge_type = HeapGraphEdge::kInternal;
+    HeapEntry::ReferenceVerification verification = HeapEntry::kVerify;
+    base::Optional<HeapEntry::Type> entry_type;
+    int index = 0;
+    const char* name = nullptr;
+    Object object;
+  };
+
   void MarkVisitedField(int offset);
 
   HeapEntry* AddEntry(HeapObject object);
@@ -412,6 +440,7 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
 
   void ExtractLocation(HeapEntry* entry, HeapObject object);
   void ExtractLocationForJSFunction(HeapEntry* entry, JSFunction func);
+  void ExtractObjectReferences(HeapEntry* entry, HeapObject obj);
   void ExtractReferences(HeapEntry* entry, HeapObject obj);
   void ExtractJSGlobalProxyReferences(HeapEntry* entry, JSGlobalProxy proxy);
   void ExtractJSObjectReferences(HeapEntry* entry, JSObject js_obj);
@@ -469,6 +498,22 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
   bool IsEssentialObject(Object object);
   bool IsEssentialHiddenReference(Object parent, int field_offset);
 
+  int NumberOfReferenceExtractionTasks();
+  bool IterateAndExtractReferencesInParallel(
+      CombinedHeapObjectIterator* iterator, int num_tasks);
+  bool ExtractsReferencesOnMainThread(HeapObject obj);
+  void DeferReferences(const std::vector<HeapObject>& objects,
+                       std::vector<DeferredReference>* references);
+  void AddDeferredReferences(const std::vector<DeferredReference>& references);
+
+  bool HasEntry(Object obj);
+  void SetNamedEdge(
+      HeapEntry* parent_entry, HeapGraphEdge::Type type, const char* name,
+      Object child_obj,
+      HeapEntry::ReferenceVerification verification = HeapEntry::kVerify);
+  void SetIndexedEdge(HeapEntry* parent_entry, HeapGraphEdge::Type type,
+                      int index, Object child_obj);
+
   void SetContextReference(HeapEntry* parent_entry, String reference_name,
                            Object child, int field_offset);
   void SetNativeBindReference(HeapEntry* parent_entry,
@@ -525,7 +570,12 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
 
   std::vector<bool> visited_fields_;
 
+  // Set on worker threads while extracting references in parallel. Changes
+  // to the snapshot are recorded here instead of being made directly.
+  std::vector<DeferredReference>* deferred_references_ = nullptr;
+
   friend class IndexedReferencesExtractor;
+  friend class ReferencesExtractionJob;
   friend class RootsReferencesExtractor;
 };
 
@@ -670,6 +720,8 @@ class HeapSnapshotJSONSerializer {
   HeapSnapshotJSONSerializer& operator=(const HeapSnapshotJSONSerializer&) =
       delete;
   void Serialize(v8::OutputStream* stream);
+  // Serialize in the binary format, see v8::HeapSnapshot::Serialize.
+  void SerializeBinary(v8::OutputStream* stream);
 
  private:
   V8_INLINE static bool StringsMatch(void* key1, void* key2) {
@@ -697,6 +749,18 @@ class HeapSnapshotJSONSerializer {
   void SerializeLocation(const SourceLocation& location);
   void SerializeLocations();
 
+  static bool IsSerializationDisabled();
+  void SerializeBinaryImpl();
+  void SerializeBinaryNodes();
+  void SerializeBinaryEdges();
+  void SerializeBinaryTraceNode(AllocationTraceNode* node);
+  void SerializeBinaryTraceNodeInfos();
+  void SerializeBinarySamples();
+  void SerializeBinaryLocations();
+  void SerializeBinaryStrings();
+
+  static const int kBinaryFormatVersion;
+
   static const int kEdgeFieldsCount;
   static const int kNodeFieldsCount;
 
@@ -0,0 +1,198 @@
+#ifndef V8_REPLAY_PROGRESS_DATA_BUFFER_H_
+#define V8_REPLAY_PROGRESS_DATA_BUFFER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace internal {
+
+// Position in the progress data kept for assertions, see ProgressDataBuffer.
+struct RecordReplayProgressDataMark {
+  uint64_t epoch = 0;
+  size_t encoded_size = 0;
+  uint64_t last_written_entry = 0;
+  uint64_t run_entry = 0;
+  uint64_t run_length = 0;
+};
+
+// When gRecordReplayAssertProgress is set we keep track of all the progress
+// made on the main thread and associate it with main-thread assertions using
+// the recorder's assert data callbacks API. Each progress advancement is
+// associated with a single 64 bit value encoding the script ID and location
+// within that script of the function which executed.
+//
+// Progress entries are stored in a compact encoding, as the same function
+// is usually entered or looped over many times in a row. Each run of equal
+// entries is written as the zigzag encoded difference from the previous run's
+// entry followed by the length of the run, both as LEB128 varints. The run
+// currently being added to is only written out when a different entry is
+// added or the data is reported, so equal entry sequences always have equal
+// encodings.
+//
+// The recorder takes the data at each assertion, but a long stretch of
+// execution without assertions can still add a lot of entries. Once the
+// encoded data exceeds kMaxEncodedSize the oldest runs are dropped, keeping
+// about half of that. Dropping is deferred while any mark is outstanding so
+// that resetting to a mark is always exact, and it happens at the same points
+// when recording and replaying as long as the same entries are added.
+class ProgressDataBuffer {
+ public:
+  static constexpr size_t kMaxEncodedSize = 8 * 1024 * 1024;
+
+  bool empty() const { return bytes_.empty() && !run_length_; }
+
+  void Add(uint64_t entry) {
+    if (run_length_ && entry == run_entry_) {
+      run_length_++;
+      return;
+    }
+    FlushRun();
+    run_entry_ = entry;
+    run_length_ = 1;
+    if (bytes_.size() > kMaxEncodedSize && !outstanding_marks_) {
+      DropOldestRuns();
+    }
+  }
+
+  // Get a mark for the current contents of the buffer. Every mark must be
+  // released with ReleaseMark() once it is no longer needed.
+  RecordReplayProgressDataMark Mark() {
+    outstanding_marks_++;
+    return { epoch_, bytes_.size(), last_written_entry_, run_entry_,
+             run_length_ };
+  }
+
+  void ReleaseMark() {
+    CHECK(outstanding_marks_);
+    outstanding_marks_--;
+  }
+
+  // Discard everything added since |mark| was taken. If the contents have
+  // been taken since then, everything still in the buffer was added after
+  // the mark and is discarded. Entries which were already taken can't be
+  // discarded.
+  void Reset(const RecordReplayProgressDataMark& mark) {
+    if (mark.epoch != epoch_) {
+      bytes_.clear();
+      last_written_entry_ = 0;
+      run_length_ = 0;
+      return;
+    }
+    DCHECK_LE(mark.encoded_size, bytes_.size());
+    bytes_.resize(mark.encoded_size);
+    last_written_entry_ = mark.last_written_entry;
+    run_entry_ = mark.run_entry;
+    run_length_ = mark.run_length;
+  }
+
+  // Take the encoded contents of the buffer, leaving it empty. Marks taken
+  // before this are out of date afterwards.
+  std::vector<uint8_t> Take() {
+    FlushRun();
+    std::vector<uint8_t> rv;
+    rv.swap(bytes_);
+    last_written_entry_ = 0;
+    epoch_++;
+    return rv;
+  }
+
+  static std::vector<uint64_t> Decode(const void* buf, size_t size) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(buf);
+    const uint8_t* end = data + size;
+    std::vector<uint64_t> entries;
+    uint64_t entry = 0;
+    while (data < end) {
+      uint64_t delta = ReadVarint(&data, end);
+      uint64_t run_length = ReadVarint(&data, end);
+      entry += ZigZagDecode(delta);
+      entries.insert(entries.end(), run_length, entry);
+    }
+    return entries;
+  }
+
+ private:
+  void FlushRun() {
+    if (!run_length_) {
+      return;
+    }
+    WriteVarint(
+        ZigZagEncode(static_cast<int64_t>(run_entry_ - last_written_entry_)));
+    WriteVarint(run_length_);
+    last_written_entry_ = run_entry_;
+    run_length_ = 0;
+  }
+
+  // Drop runs from the start of the buffer until at most half of
+  // kMaxEncodedSize is left. The first remaining run is rewritten with its
+  // entry relative to zero so the buffer can still be decoded from the start.
+  void DropOldestRuns() {
+    std::vector<uint8_t> old_bytes;
+    old_bytes.swap(bytes_);
+    const uint8_t* data = old_bytes.data();
+    const uint8_t* end = data + old_bytes.size();
+    uint64_t entry = 0;
+    while (data < end &&
+           static_cast<size_t>(end - data) > kMaxEncodedSize / 2) {
+      entry += ZigZagDecode(ReadVarint(&data, end));
+      ReadVarint(&data, end);
+    }
+    if (data == end) {
+      last_written_entry_ = 0;
+      return;
+    }
+    entry += ZigZagDecode(ReadVarint(&data, end));
+    uint64_t run_length = ReadVarint(&data, end);
+    WriteVarint(ZigZagEncode(static_cast<int64_t>(entry)));
+    WriteVarint(run_length);
+    bytes_.insert(bytes_.end(), data, end);
+  }
+
+  static uint64_t ZigZagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63);
+  }
+
+  static uint64_t ZigZagDecode(uint64_t value) {
+    return static_cast<uint64_t>(static_cast<int64_t>(value >> 1) ^
+                                 -static_cast<int64_t>(value & 1));
+  }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      bytes_.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    bytes_.push_back(static_cast<uint8_t>(value));
+  }
+
+  static uint64_t ReadVarint(const uint8_t** pdata, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      CHECK(*pdata < end);
+      uint8_t byte = *(*pdata)++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        break;
+      }
+    }
+    return value;
+  }
+
+  std::vector<uint8_t> bytes_;
+  // The entry in the last run written to |bytes_|.
+  uint64_t last_written_entry_ = 0;
+  // The run of entries which hasn't been written out yet.
+  uint64_t run_entry_ = 0;
+  uint64_t run_length_ = 0;
+  // Incremented whenever the contents are taken.
+  uint64_t epoch_ = 0;
+  size_t outstanding_marks_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_REPLAY_PROGRESS_DATA_BUFFER_H_
@@ -1,7 +1,19 @@
 #include "src/replay/replay-isolate-data.h"
 
+#include "src/execution/frames.h"
+#include "src/handles/global-handles.h"
+#include "src/objects/shared-function-info.h"
+
 namespace v8 {
 namespace replayio {
 
+ReplayIsolateData::ReplayIsolateData() = default;
+
+ReplayIsolateData::~ReplayIsolateData() {
+  if (object_ids_) {
+    internal::GlobalHandles::Destroy(object_ids_);
+  }
+}
+
 }  // namespace replayio
 }  // namespace v8
@@ -1,26 +1,64 @@
 #ifndef V8_REPLAY_REPLAY_ISOLATE_DATA_H_
 #define V8_REPLAY_REPLAY_ISOLATE_DATA_H_
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "include/v8-persistent-handle.h"
 
 namespace v8 {
+namespace internal {
+class FrameSummary;
+class SharedFunctionInfo;
+}  // namespace internal
+
 namespace replayio {
 
+// Caches and buffers used when describing the location of the topmost
+// scripted frame (see RecordReplayGetScriptedCaller) or counting frames.
+struct StackLocationCache {
+  // Bound on the number of cached script names. Script IDs are never reused,
+  // so the names of collected scripts are only dropped when this is exceeded.
+  static constexpr size_t kMaxScriptNames = 4096;
+
+  // Frame summaries for optimized frames, reused between lookups.
+  std::vector<internal::FrameSummary> summaries;
+
+  // Functions in a frame when counting frames, reused between counts.
+  std::vector<internal::SharedFunctionInfo> functions;
+
+  // Script names indexed by script ID.
+  std::unordered_map<int, std::string> script_names;
+
+  // The most recently described location.
+  int last_script_id = 0;
+  int last_source_position = -1;
+  std::string last_location;
+};
+
 // General-purpose per-Isolate data for recording and replaying.
 class ReplayIsolateData {
  public:
-  ReplayIsolateData() = default;
-  ~ReplayIsolateData() = default;
+  ReplayIsolateData();
+  ~ReplayIsolateData();
 
   ReplayIsolateData(const ReplayIsolateData&) = delete;
   ReplayIsolateData& operator=(const ReplayIsolateData&) = delete;
 
   std::vector<v8::Global<v8::Value>>& weak_ref_pins() { return weak_ref_pins_; }
 
+  // Global handle to the EphemeronHashTable from objects to their persistent
+  // IDs, shared by all contexts, or nullptr before any ID is assigned. The
+  // table is held directly so that no JS wrapper or context is kept alive.
+  internal::Address*& object_ids() { return object_ids_; }
+
+  StackLocationCache& stack_locations() { return stack_locations_; }
+
  private:
   std::vector<v8::Global<v8::Value>> weak_ref_pins_;
+  internal::Address* object_ids_ = nullptr;
+  StackLocationCache stack_locations_;
 };
 
 }  // namespace replayio
@@ -26,5 +26,29 @@ v8::internal::MaybeHandle<v8::internal::String> RecordReplayStringHandle(
   return RecordReplayStringHandle(why, isolate, input.ToHandleChecked());
 }
 
+static thread_local std::vector<uint8_t> gRecordReplayBatchBuffer;
+static thread_local bool gRecordReplayBatchActive;
+
+RecordReplayBatch::RecordReplayBatch(const char* why)
+    : why_(why), buffer_(gRecordReplayBatchBuffer) {
+  CHECK(!gRecordReplayBatchActive);
+  gRecordReplayBatchActive = true;
+  buffer_.clear();
+}
+
+RecordReplayBatch::~RecordReplayBatch() {
+  DCHECK(!pending_);
+  gRecordReplayBatchActive = false;
+}
+
+void RecordReplayBatch::Flush() {
+  if (buffer_.size() > flushed_size_) {
+    v8::recordreplay::RecordReplayBytes(why_, buffer_.data() + flushed_size_,
+                                        buffer_.size() - flushed_size_);
+    flushed_size_ = buffer_.size();
+  }
+  pending_ = false;
+}
+
 }  // namespace replayio
 }  // namespace v8
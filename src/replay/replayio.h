@@ -1,6 +1,11 @@
 #ifndef V8_REPLAY_REPLAYIO_H_
 #define V8_REPLAY_REPLAYIO_H_
 
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "src/base/logging.h"
 #include "src/handles/handles.h"
 #include "src/handles/maybe-handles.h"
 
@@ -20,6 +25,56 @@ v8::internal::MaybeHandle<v8::internal::String> RecordReplayStringHandle(
     const char* why, v8::internal::Isolate* isolate,
     v8::internal::MaybeHandle<v8::internal::String> input);
 
+// Records or replays a sequence of values with the same "why" in a single
+// call into the driver, instead of one call per value. Values are staged with
+// Add and recorded by Flush. When replaying, Flush replaces the staged values
+// with the recorded ones, so values must only be consumed afterwards.
+// Like RecordReplayBytes, nothing is recorded if the "values" feature is
+// disabled for the batch's "why", so callers which check first should use the
+// same "why" as the subfeature.
+//
+// The staging buffer is per thread and reused between batches, so only one
+// batch can be active on a thread at a time.
+class RecordReplayBatch {
+ public:
+  explicit RecordReplayBatch(const char* why);
+  ~RecordReplayBatch();
+
+  RecordReplayBatch(const RecordReplayBatch&) = delete;
+  RecordReplayBatch& operator=(const RecordReplayBatch&) = delete;
+
+  template <typename T>
+  void Add(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Batched values are recorded as bytes");
+    size_t offset = buffer_.size();
+    buffer_.resize(offset + sizeof(T));
+    memcpy(buffer_.data() + offset, &value, sizeof(T));
+    pending_ = true;
+  }
+
+  // Record or replay all values added since the last flush.
+  void Flush();
+
+  // Read back the value at the given index, after flushing. All values in the
+  // batch must have the same type.
+  template <typename T>
+  T Get(size_t index) const {
+    DCHECK(!pending_);
+    DCHECK_LE((index + 1) * sizeof(T), buffer_.size());
+    T value;
+    memcpy(&value, buffer_.data() + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+ private:
+  const char* why_;
+  std::vector<uint8_t>& buffer_;
+  // Size of the buffer when it was last flushed.
+  size_t flushed_size_ = 0;
+  bool pending_ = false;
+};
+
 }  // namespace replayio
 }  // namespace v8
 
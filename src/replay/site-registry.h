@@ -0,0 +1,185 @@
+#ifndef V8_REPLAY_SITE_REGISTRY_H_
+#define V8_REPLAY_SITE_REGISTRY_H_
+
+#include <atomic>
+
+#include "include/v8.h"
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace replayio {
+
+// Append-only registry of sites which are referred to by index from bytecode,
+// such as assertion and instrumentation sites.
+//
+// Sites can be added from any thread. Each thread reserves a block of
+// kSegmentSize indexes at a time and fills it in privately, so threads
+// compiling in parallel don't contend with each other. Blocks are reserved
+// while holding an ordered lock, so they are handed out in the same order when
+// replaying as when recording and site indexes are stable between the two.
+// Unused indexes at the end of a thread's block are never filled in. A thread
+// only keeps its block for the registry it last added to, so registries of the
+// same site type should not be used in alternation.
+//
+// Each block is backed by its own segment, and segments are found through
+// chunks of segment pointers which are allocated as the registry grows. Neither
+// ever moves once allocated, so reading a site is wait-free.
+template <typename T>
+class SiteRegistry {
+ public:
+  static constexpr size_t kSegmentSize = 4096;
+  static constexpr size_t kSegmentsPerChunk = 64;
+  static constexpr size_t kMaxChunks = 8192;
+  static constexpr size_t kMaxSites =
+      kSegmentSize * kSegmentsPerChunk * kMaxChunks;
+
+  explicit SiteRegistry(const char* name)
+      : name_(name),
+        id_(next_id_.fetch_add(1, std::memory_order_relaxed)),
+        ordered_lock_id_(
+            static_cast<int>(recordreplay::CreateOrderedLock(name))) {}
+  ~SiteRegistry() {
+    for (std::atomic<Chunk*>& entry : chunks_) {
+      Chunk* chunk = entry.load(std::memory_order_relaxed);
+      if (!chunk) {
+        continue;
+      }
+      for (std::atomic<Segment*>& segment : chunk->segments) {
+        delete segment.load(std::memory_order_relaxed);
+      }
+      delete chunk;
+    }
+  }
+
+  SiteRegistry(const SiteRegistry&) = delete;
+  SiteRegistry& operator=(const SiteRegistry&) = delete;
+
+  // Add a site and return its index. The site is visible to other threads
+  // once this returns.
+  size_t Add(T site) {
+    ThreadBlock& block = thread_block_;
+    if (block.registry_id != id_ || block.next == block.end) {
+      ReserveBlock(&block);
+    }
+    size_t index = block.next++;
+    Slot& slot = block.segment->slots[index % kSegmentSize];
+    slot.site = std::move(site);
+    slot.published.store(true, std::memory_order_release);
+    return index;
+  }
+
+  // Get a site previously added on any thread, or nullptr if there is no
+  // such site.
+  T* TryGet(size_t index) {
+    if (index >= kMaxSites) {
+      return nullptr;
+    }
+    size_t segment_index = index / kSegmentSize;
+    Chunk* chunk = chunks_[segment_index / kSegmentsPerChunk].load(
+        std::memory_order_acquire);
+    if (!chunk) {
+      return nullptr;
+    }
+    Segment* segment = chunk->segments[segment_index % kSegmentsPerChunk].load(
+        std::memory_order_acquire);
+    if (!segment) {
+      return nullptr;
+    }
+    Slot& slot = segment->slots[index % kSegmentSize];
+    if (!slot.published.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slot.site;
+  }
+
+  // Upper bound on the indexes which have been handed out so far.
+  size_t ReservedCount() const {
+    return reserved_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    T site;
+    std::atomic<bool> published{false};
+  };
+
+  struct Segment {
+    Slot slots[kSegmentSize];
+  };
+
+  struct Chunk {
+    std::atomic<Segment*> segments[kSegmentsPerChunk] = {};
+  };
+
+  // Indexes reserved by the current thread which haven't been used yet.
+  struct ThreadBlock {
+    size_t registry_id = 0;
+    size_t next = 0;
+    size_t end = 0;
+    Segment* segment = nullptr;
+  };
+
+  void ReserveBlock(ThreadBlock* block) {
+    recordreplay::OrderedLock(ordered_lock_id_);
+    size_t start = reserved_.fetch_add(kSegmentSize, std::memory_order_relaxed);
+    recordreplay::OrderedUnlock(ordered_lock_id_);
+    if (start >= kMaxSites) {
+      recordreplay::Diagnostic("SiteRegistry %s full, %zu sites", name_,
+                               kMaxSites);
+      FATAL("SiteRegistry %s can't hold more than %zu sites", name_,
+            kMaxSites);
+    }
+
+    // The block covers a whole segment, so no other thread stores into it.
+    size_t segment_index = start / kSegmentSize;
+    Segment* segment = new Segment();
+    EnsureChunk(segment_index / kSegmentsPerChunk)
+        ->segments[segment_index % kSegmentsPerChunk]
+        .store(segment, std::memory_order_release);
+
+    block->registry_id = id_;
+    block->next = start;
+    block->end = start + kSegmentSize;
+    block->segment = segment;
+  }
+
+  Chunk* EnsureChunk(size_t chunk_index) {
+    std::atomic<Chunk*>& entry = chunks_[chunk_index];
+    Chunk* chunk = entry.load(std::memory_order_acquire);
+    if (chunk) {
+      return chunk;
+    }
+    Chunk* new_chunk = new Chunk();
+    if (entry.compare_exchange_strong(chunk, new_chunk,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+      return new_chunk;
+    }
+    // Another thread installed the chunk first.
+    delete new_chunk;
+    return chunk;
+  }
+
+  // Registries are told apart by ID rather than address, as a new registry
+  // could be allocated where a deleted one used to be.
+  static std::atomic<size_t> next_id_;
+  static thread_local ThreadBlock thread_block_;
+
+  const char* const name_;
+  const size_t id_;
+  const int ordered_lock_id_;
+  std::atomic<size_t> reserved_{0};
+  std::atomic<Chunk*> chunks_[kMaxChunks] = {};
+};
+
+template <typename T>
+std::atomic<size_t> SiteRegistry<T>::next_id_{1};
+
+template <typename T>
+thread_local typename SiteRegistry<T>::ThreadBlock
+    SiteRegistry<T>::thread_block_;
+
+}  // namespace replayio
+}  // namespace v8
+
+#endif  // V8_REPLAY_SITE_REGISTRY_H_
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <unordered_map>
 #include <vector>
 
 #include "src/common/globals.h"
@@ -14,6 +15,8 @@
 #include "src/heap/heap-inl.h"  // For ToBoolean. TODO(jkummerow): Drop.
 #include "src/interpreter/bytecodes.h"
 #include "src/interpreter/interpreter.h"
+#include "src/logging/runtime-call-stats-scope.h"
+#include "src/logging/tracing-flags.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/js-collection-inl.h"
 #include "src/objects/js-generator-inl.h"
@@ -35,6 +38,9 @@
 
 #include "src/api/api-inl.h"
 #include "src/base/replayio.h"
+#include "src/replay/progress-data-buffer.h"
+#include "src/replay/replay-isolate-data.h"
+#include "src/replay/site-registry.h"
 
 namespace v8 {
 namespace internal {
@@ -947,7 +953,7 @@ RUNTIME_FUNCTION(Runtime_ProfileCreateSnapshotDataBlob) {
 extern uint64_t* gProgressCounter;
 extern uint64_t gTargetProgress;
 extern bool gRecordReplayAssertProgress;
-extern int gRecordReplayCheckProgress;
+extern intptr_t gRecordReplayCheckProgress;
 
 // Define this to check preconditions for using record/replay opcodes.
 //#define RECORD_REPLAY_CHECK_OPCODES
@@ -973,43 +979,42 @@ static inline bool RecordReplayBytecodeAllowed() {
 
 #endif // !RECORD_REPLAY_CHECK_OPCODES
 
-// When gRecordReplayAssertProgress is set we keep track of all the progress
-// made on the main thread and associate it with main-thread assertions using
-// the recorder's assert data callbacks API. Each progress advancement is
-// associated with a single 64 bit value encoding the script ID and location
-// within that script of the function which executed.
-static std::vector<uint64_t>* gProgressData;
+static ProgressDataBuffer* gProgressData;
 
 RecordReplayScrubDivergentProgressScope::
     RecordReplayScrubDivergentProgressScope()
-    : active_(false), start_progress_(0), start_data_size_(0) {
+    : active_(false), has_data_mark_(false), start_progress_(0) {
   if (!recordreplay::IsRecordingOrReplaying() || !IsMainThread()) return;
   if (!recordreplay::AreEventsDisallowed()) return;
   if (recordreplay::HasDivergedFromRecording()) return;
   active_ = true;
   start_progress_ = *gProgressCounter;
-  start_data_size_ = gProgressData ? gProgressData->size() : 0;
+  if (gProgressData) {
+    start_data_mark_ = gProgressData->Mark();
+    has_data_mark_ = true;
+  }
 }
 
 RecordReplayScrubDivergentProgressScope::
     ~RecordReplayScrubDivergentProgressScope() {
   if (!active_) return;
-  if (recordreplay::HasDivergedFromRecording()) return;
-  if (start_progress_ >= *gProgressCounter) return;
-  // [RUN-1988] Divergent path advanced PC via instrumented user code.
-  *gProgressCounter = start_progress_;
-  if (start_data_size_ == 0) {
+  if (!recordreplay::HasDivergedFromRecording() &&
+      start_progress_ < *gProgressCounter) {
+    // [RUN-1988] Divergent path advanced PC via instrumented user code.
+    *gProgressCounter = start_progress_;
     if (gProgressData) {
-      delete gProgressData;
-      gProgressData = nullptr;
+      // If the buffer was created within this scope the default mark
+      // refers to its empty initial state.
+      gProgressData->Reset(start_data_mark_);
     }
-  } else if (gProgressData && gProgressData->size() > start_data_size_) {
-    gProgressData->resize(start_data_size_);
+  }
+  if (has_data_mark_) {
+    gProgressData->ReleaseMark();
   }
 }
 
 // Buffer holding data most recently reported to the recorder.
-static std::vector<uint64_t>* gReportedProgressData;
+static std::vector<uint8_t>* gReportedProgressData;
 
 static inline uint64_t BuildScriptProgressEntry(Handle<JSFunction> fun) {
   int script_id = Script::cast(fun->shared().script()).id();
@@ -1124,24 +1129,27 @@ void RecordReplayCallbackAssertGetData(void** pbuf, size_t* psize) {
     return;
   }
 
-  if (gReportedProgressData) {
-    delete gReportedProgressData;
+  if (!gReportedProgressData) {
+    gReportedProgressData = new std::vector<uint8_t>();
   }
-  gReportedProgressData = gProgressData;
-  gProgressData = nullptr;
-  *pbuf = &(*gReportedProgressData)[0];
-  *psize = gReportedProgressData->size() * sizeof(uint64_t);
+  *gReportedProgressData = gProgressData->Take();
+  *pbuf = gReportedProgressData->data();
+  *psize = gReportedProgressData->size();
 }
 
 extern void RecordReplayDescribeAssertData(const char* text);
 
 char* RecordReplayCallbackAssertOnDataMismatch(void* recorded_buf, size_t recorded_buf_size,
                                                void* replayed_buf, size_t replayed_buf_size) {
-  const uint64_t* recorded = reinterpret_cast<const uint64_t*>(recorded_buf);
-  size_t recorded_size = recorded_buf_size / sizeof(uint64_t);
+  std::vector<uint64_t> recorded_entries =
+      ProgressDataBuffer::Decode(recorded_buf, recorded_buf_size);
+  const uint64_t* recorded = recorded_entries.data();
+  size_t recorded_size = recorded_entries.size();
 
-  const uint64_t* replayed = reinterpret_cast<const uint64_t*>(replayed_buf);
-  size_t replayed_size = replayed_buf_size / sizeof(uint64_t);
+  std::vector<uint64_t> replayed_entries =
+      ProgressDataBuffer::Decode(replayed_buf, replayed_buf_size);
+  const uint64_t* replayed = replayed_entries.data();
+  size_t replayed_size = replayed_entries.size();
 
   // Find the first divergent index. Equal entries up to here ran in lockstep.
   size_t firstDivergentIndex = 0;
@@ -1160,17 +1168,50 @@ char* RecordReplayCallbackAssertOnDataMismatch(void* recorded_buf, size_t record
 }
 
 void RecordReplayCallbackAssertDescribeData(void* buf, size_t buf_size) {
-  const uint64_t* entries = reinterpret_cast<const uint64_t*>(buf);
-  size_t size = buf_size / sizeof(uint64_t);
-
-  for (size_t i = 0; i < size; i++) {
-    std::string text = GetScriptProgressEntryString(entries[i]);
+  for (uint64_t entry : ProgressDataBuffer::Decode(buf, buf_size)) {
+    std::string text = GetScriptProgressEntryString(entry);
     RecordReplayDescribeAssertData(text.c_str());
   }
 }
 
 extern bool gRecordReplayHasCheckpoint;
 
+#ifdef V8_RUNTIME_CALL_STATS
+// Get the counter for a record/replay hook according to the tier of the
+// topmost JS frame, which made the call.
+static RuntimeCallCounterId RecordReplayHookCounterId(
+    Isolate* isolate, RuntimeCallCounterId ignition_counter_id) {
+  int tier = 0;
+  JavaScriptStackFrameIterator it(isolate);
+  if (!it.done()) {
+    switch (it.frame()->type()) {
+      case StackFrame::BASELINE:
+        tier = 1;
+        break;
+      case StackFrame::MAGLEV:
+        tier = 2;
+        break;
+      case StackFrame::TURBOFAN:
+        tier = 3;
+        break;
+      default:
+        break;
+    }
+  }
+  return static_cast<RuntimeCallCounterId>(
+      static_cast<int>(ignition_counter_id) + tier);
+}
+#endif  // V8_RUNTIME_CALL_STATS
+
+// Count calls and time spent in a record/replay hook per tier with
+// --runtime-call-stats.
+#define RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, Hook)                  \
+  RCS_SCOPE(isolate,                                                 \
+            V8_LIKELY(!TracingFlags::is_runtime_stats_enabled())     \
+                ? RuntimeCallCounterId::k##Hook##_Ignition           \
+                : RecordReplayHookCounterId(                         \
+                      isolate, RuntimeCallCounterId::k##Hook##_Ignition))
+
 extern void RecordReplayOnTargetProgressReached();
 extern bool RecordReplayIsDivergentUserJSWithoutPause(
     const SharedFunctionInfo& shared);
@@ -1178,6 +1219,7 @@ extern bool RecordReplayIsDivergentUserJSWithoutPause(
 static bool gHasPrintedStack = false;
 
 RUNTIME_FUNCTION(Runtime_RecordReplayAssertExecutionProgress) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayAssertExecutionProgress);
   if (++*gProgressCounter == gTargetProgress) {
     RecordReplayOnTargetProgressReached();
   }
@@ -1186,9 +1228,9 @@ RUNTIME_FUNCTION(Runtime_RecordReplayAssertExecutionProgress) {
     Handle<JSFunction> function = args.at<JSFunction>(0);
 
     if (!gProgressData) {
-      gProgressData = new std::vector<uint64_t>();
+      gProgressData = new ProgressDataBuffer();
     }
-    gProgressData->push_back(BuildScriptProgressEntry(function));
+    gProgressData->Add(BuildScriptProgressEntry(function));
   }
 
   if (gRecordReplayCheckProgress) {
@@ -1224,12 +1266,6 @@ RUNTIME_FUNCTION(Runtime_RecordReplayAssertExecutionProgress) {
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
-RUNTIME_FUNCTION(Runtime_RecordReplayTargetProgressReached) {
-  CHECK(*gProgressCounter == gTargetProgress);
-  RecordReplayOnTargetProgressReached();
-  return ReadOnlyRoots(isolate).undefined_value();
-}
-
 extern "C" void V8RecordReplayNotifyActivity();
 
 RUNTIME_FUNCTION(Runtime_RecordReplayNotifyActivity) {
@@ -1237,54 +1273,94 @@ RUNTIME_FUNCTION(Runtime_RecordReplayNotifyActivity) {
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
+static const std::string& GetStackLocationScriptName(
+    replayio::StackLocationCache& cache, Script script) {
+  auto iter = cache.script_names.find(script.id());
+  if (iter != cache.script_names.end()) {
+    return iter->second;
+  }
+  if (cache.script_names.size() >=
+      replayio::StackLocationCache::kMaxScriptNames) {
+    cache.script_names.clear();
+  }
+  std::string name = "<none>";
+  if (!script.name().IsUndefined()) {
+    name = String::cast(script.name()).ToCString().get();
+  }
+  return cache.script_names.emplace(script.id(), std::move(name))
+      .first->second;
+}
+
 static std::string GetStackLocation(Isolate* isolate) {
   HandleScope scope(isolate);
-  char location[1024];
-  strcpy(location, "<no frame>");
+  replayio::StackLocationCache& cache =
+      isolate->EnsureReplayData()->stack_locations();
   for (StackFrameIterator it(isolate); !it.done(); it.Advance()) {
     StackFrame* frame = it.frame();
     if (!frame->is_java_script()) {
       continue;
     }
-    std::vector<FrameSummary> frames;
-    CommonFrame::cast(frame)->Summarize(&frames);
-    if (!frames.size()) {
-      continue;
-    }
-    auto& summary = frames.back();
-    CHECK(summary.IsJavaScript());
-    auto const& js = summary.AsJavaScript();
 
-    Handle<SharedFunctionInfo> shared(js.function()->shared(), isolate);
+    SharedFunctionInfo shared;
+    int source_position;
+    if (frame->is_unoptimized()) {
+      // Unoptimized frames never have inlined functions, so the position can
+      // be read directly instead of summarizing the frame.
+      JavaScriptFrame* js_frame = JavaScriptFrame::cast(frame);
+      shared = js_frame->function().shared();
+      source_position = js_frame->position();
+    } else {
+      std::vector<FrameSummary>& frames = cache.summaries;
+      frames.clear();
+      CommonFrame::cast(frame)->Summarize(&frames);
+      if (!frames.size()) {
+        continue;
+      }
+      auto& summary = frames.back();
+      CHECK(summary.IsJavaScript());
+      auto const& js = summary.AsJavaScript();
+      shared = js.function()->shared();
+      source_position = js.SourcePosition();
+      frames.clear();
+    }
 
     // Sometimes the SharedFunctionInfo has what appears to be a bogus
     // script for an unknown reason. We check the positions of the function
     // to watch for this.
-    if (!shared->StartPosition() && !shared->EndPosition()) {
+    if (!shared.StartPosition() && !shared.EndPosition()) {
       continue;
     }
 
-    Handle<Script> script(Script::cast(shared->script()), isolate);
-
-    if (script->id() == 0) {
+    Script raw_script = Script::cast(shared.script());
+    if (raw_script.id() == 0) {
       continue;
     }
 
-    int source_position = js.SourcePosition();
+    // Callers usually ask about the same location many times in a row, in
+    // which case the description can be reused.
+    if (raw_script.id() == cache.last_script_id &&
+        source_position == cache.last_source_position) {
+      return cache.last_location;
+    }
+
+    // Line ends are computed once and cached on the script.
+    Handle<Script> script(raw_script, isolate);
     Script::PositionInfo info;
     Script::GetPositionInfo(script, source_position, &info, Script::WITH_OFFSET);
 
-    if (script->name().IsUndefined()) {
-      snprintf(location, sizeof(location), "<none>:%d:%d", info.line + 1, info.column);
-    } else {
-      std::unique_ptr<char[]> name = String::cast(script->name()).ToCString();
-      snprintf(location, sizeof(location), "%s:%d:%d", name.get(), info.line + 1, info.column);
-    }
+    char location[1024];
+    snprintf(location, sizeof(location), "%s:%d:%d",
+             GetStackLocationScriptName(cache, *script).c_str(), info.line + 1,
+             info.column);
     location[sizeof(location) - 1] = 0;
-    break;
+
+    cache.last_script_id = script->id();
+    cache.last_source_position = source_position;
+    cache.last_location = location;
+    return cache.last_location;
   }
 
-  return std::string(location);
+  return "<no frame>";
 }
 
 // Assertion and instrumentation site indexes embedded in bytecodes are offset
@@ -1296,34 +1372,31 @@ static const int BytecodeSiteOffset = 1 << 16;
 // Locations for each assertion site, filled in lazily.
 struct AssertionSite {
   std::string desc_;
-  int source_position_;
+  int source_position_ = 0;
   std::string location_;
 };
-typedef std::vector<AssertionSite*> AssertionSiteVector;
-static AssertionSiteVector* gAssertionSites;
-static base::Mutex* gAssertionSitesMutex;
 
-int RegisterAssertValueSite(const std::string& desc, int source_position) {
-  base::MutexGuard lock(gAssertionSitesMutex);
+// All assertion sites that have been registered, possibly on a non-main
+// thread during background compilation tasks.
+static replayio::SiteRegistry<AssertionSite>* gAssertionSites;
 
-  int index = (int)gAssertionSites->size();
-  gAssertionSites->push_back(new AssertionSite({ desc, source_position, "" }));
-  return index + BytecodeSiteOffset;
+int RegisterAssertValueSite(const std::string& desc, int source_position) {
+  size_t index = gAssertionSites->Add({ desc, source_position, "" });
+  return static_cast<int>(index) + BytecodeSiteOffset;
 }
 
 static inline AssertionSite& GetAssertValueSite(int32_t index) {
   index -= BytecodeSiteOffset;
 
-  base::MutexGuard lock(gAssertionSitesMutex);
-
-  CHECK(gAssertionSites && (size_t)index < gAssertionSites->size());
-  AssertionSite* site = (*gAssertionSites)[index];
+  AssertionSite* site = index >= 0 ? gAssertionSites->TryGet(index) : nullptr;
+  CHECK(site);
   return *site;
 }
 
 extern std::string RecordReplayBasicValueContents(Handle<Object> value);
 
 RUNTIME_FUNCTION(Runtime_RecordReplayAssertValue) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayAssertValue);
   CHECK(RecordReplayBytecodeAllowed());
 
   HandleScope scope(isolate);
@@ -1388,30 +1461,20 @@ struct InstrumentationSite {
   // The index of this site within its function.
   int function_index_ = 0;
 
-  // Set on the first use of the instrumentation site.
+  // Set on the first use of the instrumentation site. When the driver supports
+  // the integer instrumentation callback, kind_id_ is non-negative and the
+  // script ID and function start are passed directly. Otherwise function_id_
+  // holds the formatted function ID.
+  bool resolved_ = false;
+  int kind_id_ = -1;
+  int script_id_ = 0;
+  int function_start_ = 0;
   std::string function_id_;
 };
 
-typedef std::vector<InstrumentationSite> InstrumentationSiteVector;
-
 // All instrumentation sites that have been registered, possibly on a non-main
-// thread during background compilation tasks. Protected by gInstrumentationSitesMutex.
-static InstrumentationSiteVector* gInstrumentationSites;
-static base::Mutex* gInstrumentationSitesMutex;
-
-// Prefix of gInstrumentationSites, main thread only. Used to avoid locking.
-static InstrumentationSiteVector* gMainThreadInstrumentationSites;
-
-// On the main thread, copy over any instrumentation sites that haven't
-// been added to gMainThreadInstrumentationSites.
-static void CopyMainThreadInstrumentationSites() {
-  base::MutexGuard lock(gInstrumentationSitesMutex);
-  for (size_t i = gMainThreadInstrumentationSites->size();
-       i < gInstrumentationSites->size();
-       i++) {
-    gMainThreadInstrumentationSites->push_back((*gInstrumentationSites)[i]);
-  }
-}
+// thread during background compilation tasks.
+static replayio::SiteRegistry<InstrumentationSite>* gInstrumentationSites;
 
 int RegisterInstrumentationSite(const char* kind, int source_position,
                                 int function_index) {
@@ -1420,26 +1483,21 @@ int RegisterInstrumentationSite(const char* kind, int source_position,
   site.source_position_ = source_position;
   site.function_index_ = function_index;
 
-  base::MutexGuard lock(gInstrumentationSitesMutex);
-
-  int index = (int)gInstrumentationSites->size();
-  gInstrumentationSites->push_back(site);
-
-  return index + BytecodeSiteOffset;
+  size_t index = gInstrumentationSites->Add(std::move(site));
+  return static_cast<int>(index) + BytecodeSiteOffset;
 }
 
 static InstrumentationSite& GetInstrumentationSite(const char* why, int index) {
   CHECK(IsMainThread());
   index -= BytecodeSiteOffset;
-  if ((size_t)index >= gMainThreadInstrumentationSites->size()) {
-    CopyMainThreadInstrumentationSites();
-    if ((size_t)index >= gMainThreadInstrumentationSites->size()) {
-      recordreplay::Diagnostic("BadInstrumentationSite %s %d %d",
-                               why, index, gMainThreadInstrumentationSites->size());
-      CHECK((size_t)index < gMainThreadInstrumentationSites->size());
-    }
+  InstrumentationSite* site =
+      index >= 0 ? gInstrumentationSites->TryGet(index) : nullptr;
+  if (!site) {
+    recordreplay::Diagnostic("BadInstrumentationSite %s %d %zu",
+                             why, index, gInstrumentationSites->ReservedCount());
+    CHECK(site);
   }
-  return (*gMainThreadInstrumentationSites)[index];
+  return *site;
 }
 
 const char* InstrumentationSiteKind(int index) {
@@ -1456,14 +1514,16 @@ int InstrumentationSiteFunctionIndex(int index) {
 
 void RecordReplayInitInstrumentationState() {
   // These can't have static ctors/dtors...
-  gAssertionSites = new AssertionSiteVector();
-  gAssertionSitesMutex = new base::Mutex();
-  gInstrumentationSites = new InstrumentationSiteVector();
-  gInstrumentationSitesMutex = new base::Mutex();
-  gMainThreadInstrumentationSites = new InstrumentationSiteVector();
+  gAssertionSites =
+      new replayio::SiteRegistry<AssertionSite>("AssertionSites");
+  gInstrumentationSites =
+      new replayio::SiteRegistry<InstrumentationSite>("InstrumentationSites");
 }
 
 extern void RecordReplayInstrument(const char* kind, const char* function, int function_index);
+extern int RecordReplayInstrumentationKindId(const char* kind);
+extern void RecordReplayInstrumentRaw(int kind_id, int script_id,
+                                      int function_start, int function_index);
 
 // Enable to dump locations of each function to stderr.
 static bool gDumpFunctionLocations;
@@ -1510,19 +1570,39 @@ static inline void OnInstrumentation(Isolate* isolate,
 
   InstrumentationSite& site = GetInstrumentationSite("Callback", index);
 
-  if (!site.function_id_.length()) {
-    Handle<SharedFunctionInfo> shared(function->shared(), isolate);
-    site.function_id_ = GetRecordReplayFunctionId(shared);
+  if (!site.resolved_) {
+    site.resolved_ = true;
+    site.kind_id_ = RecordReplayInstrumentationKindId(site.kind_);
+    if (site.kind_id_ >= 0) {
+      site.script_id_ = script->id();
+      site.function_start_ = function->shared().StartPosition();
+    } else {
+      Handle<SharedFunctionInfo> shared(function->shared(), isolate);
+      site.function_id_ = GetRecordReplayFunctionId(shared);
+    }
   }
 
-  RecordReplayInstrument(site.kind_, site.function_id_.c_str(),
-                         site.function_index_);
+  if (site.kind_id_ >= 0) {
+    RecordReplayInstrumentRaw(site.kind_id_, site.script_id_,
+                              site.function_start_, site.function_index_);
+  } else {
+    RecordReplayInstrument(site.kind_, site.function_id_.c_str(),
+                           site.function_index_);
+  }
 }
 
-extern bool gRecordReplayInstrumentationEnabled;
+extern intptr_t gRecordReplayInstrumentationEnabled;
+
+// Whether instrumentation callbacks should be invoked for a function, either
+// because instrumentation is enabled everywhere or only for that function.
+static inline bool IsRecordReplayInstrumented(Object function) {
+  return gRecordReplayInstrumentationEnabled ||
+         JSFunction::cast(function).shared().record_replay_instrumented();
+}
 
 RUNTIME_FUNCTION(Runtime_RecordReplayInstrumentation) {
-  if (!gRecordReplayInstrumentationEnabled) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayInstrumentation);
+  if (!IsRecordReplayInstrumented(args[0])) {
     return ReadOnlyRoots(isolate).undefined_value();
   }
 
@@ -1546,6 +1626,7 @@ int RecordReplayCurrentGeneratorIdRaw() {
 }
 
 RUNTIME_FUNCTION(Runtime_RecordReplayInstrumentationGenerator) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayInstrumentationGenerator);
   HandleScope scope(isolate);
   DCHECK_EQ(3, args.length());
   Handle<JSFunction> function = args.at<JSFunction>(0);
@@ -1561,7 +1642,7 @@ RUNTIME_FUNCTION(Runtime_RecordReplayInstrumentationGenerator) {
                                              v8::Utils::ToLocal(generator_object),
                                              /* allow_create */ true);
 
-  if (gRecordReplayInstrumentationEnabled) {
+  if (IsRecordReplayInstrumented(*function)) {
     OnInstrumentation(isolate, function, index);
   }
 
@@ -1573,7 +1654,8 @@ RUNTIME_FUNCTION(Runtime_RecordReplayInstrumentationGenerator) {
 static Handle<Object>* gCurrentReturnValue;
 
 RUNTIME_FUNCTION(Runtime_RecordReplayInstrumentationReturn) {
-  if (!gRecordReplayInstrumentationEnabled) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayInstrumentationReturn);
+  if (!IsRecordReplayInstrumented(args[0])) {
     return ReadOnlyRoots(isolate).undefined_value();
   }
 
@@ -1601,6 +1683,7 @@ extern "C" bool V8RecordReplayCurrentReturnValue(v8::Local<v8::Value>* object) {
 }
 
 RUNTIME_FUNCTION(Runtime_RecordReplayTrackObjectId) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayTrackObjectId);
   DCHECK_EQ(1, args.length());
   Handle<Object> value = args.at(0);
 
@@ -1612,6 +1695,15 @@ RUNTIME_FUNCTION(Runtime_RecordReplayTrackObjectId) {
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
+// Called by ReplayIncJsFrameDepth in every tier when the JS frame depth
+// reaches its limit. The increment itself is done inline and isn't counted.
+RUNTIME_FUNCTION(Runtime_RecordReplayThrowJsFrameDepthOverflow) {
+  RECORD_REPLAY_HOOK_RCS_SCOPE(isolate, RecordReplayThrowJsFrameDepthOverflow);
+  SealHandleScope shs(isolate);
+  DCHECK_EQ(0, args.length());
+  return isolate->StackOverflow();
+}
+
 }  // namespace internal
 
 std::string RecordReplayGetScriptedCaller() {
@@ -124,6 +124,7 @@ bool Runtime::NeedsExactContext(FunctionId id) {
     case Runtime::kThrowReferenceError:
     case Runtime::kThrowAccessedUninitializedVariable:
     case Runtime::kThrowStackOverflow:
+    case Runtime::kRecordReplayThrowJsFrameDepthOverflow:
     case Runtime::kThrowStaticPrototypeError:
     case Runtime::kThrowSuperAlreadyCalledError:
     case Runtime::kThrowSuperNotCalled:
@@ -168,6 +169,7 @@ bool Runtime::IsNonReturning(FunctionId id) {
     case Runtime::kThrowReferenceError:
     case Runtime::kThrowAccessedUninitializedVariable:
     case Runtime::kThrowStackOverflow:
+    case Runtime::kRecordReplayThrowJsFrameDepthOverflow:
     case Runtime::kThrowSymbolAsyncIteratorInvalid:
     case Runtime::kThrowTypeError:
     case Runtime::kThrowConstAssignError:
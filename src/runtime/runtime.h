@@ -122,40 +122,40 @@ namespace internal {
 
 #define FOR_EACH_INTRINSIC_DATE(F, I) F(DateCurrentTime, 0, 1)
 
-#define FOR_EACH_INTRINSIC_DEBUG(F, I)          \
-  F(ClearStepping, 0, 1)                        \
-  F(CollectGarbage, 1, 1)                       \
-  F(DebugAsyncFunctionSuspended, 4, 1)          \
-  F(DebugBreakAtEntry, 1, 1)                    \
-  F(DebugCollectCoverage, 0, 1)                 \
-  F(DebugGetLoadedScriptIds, 0, 1)              \
-  F(DebugOnFunctionCall, 2, 1)                  \
-  F(DebugPopPromise, 0, 1)                      \
-  F(DebugPrepareStepInSuspendedGenerator, 0, 1) \
-  F(DebugPromiseThen, 1, 1)                     \
-  F(DebugPushPromise, 1, 1)                     \
-  F(DebugToggleBlockCoverage, 1, 1)             \
-  F(DebugTogglePreciseCoverage, 1, 1)           \
-  F(FunctionGetInferredName, 1, 1)              \
-  F(GetBreakLocations, 1, 1)                    \
-  F(GetGeneratorScopeCount, 1, 1)               \
-  F(GetGeneratorScopeDetails, 2, 1)             \
-  F(HandleDebuggerStatement, 0, 1)              \
-  F(IsBreakOnException, 1, 1)                   \
-  F(LiveEditPatchScript, 2, 1)                  \
-  F(ProfileCreateSnapshotDataBlob, 0, 1)        \
-  F(ScheduleBreak, 0, 1)                        \
-  F(ScriptLocationFromLine2, 4, 1)              \
-  F(SetGeneratorScopeVariableValue, 4, 1)       \
-  I(IncBlockCounter, 2, 1)                      \
-  F(RecordReplayAssertExecutionProgress, 1, 1)  \
-  F(RecordReplayTargetProgressReached, 0, 1)    \
-  F(RecordReplayNotifyActivity, 0, 1)           \
-  F(RecordReplayAssertValue, 3, 1)              \
-  F(RecordReplayInstrumentation, 2, 1)          \
-  F(RecordReplayInstrumentationGenerator, 3, 1) \
-  F(RecordReplayInstrumentationReturn, 3, 1)    \
-  F(RecordReplayTrackObjectId, 1, 1)
+#define FOR_EACH_INTRINSIC_DEBUG(F, I)           \
+  F(ClearStepping, 0, 1)                         \
+  F(CollectGarbage, 1, 1)                        \
+  F(DebugAsyncFunctionSuspended, 4, 1)           \
+  F(DebugBreakAtEntry, 1, 1)                     \
+  F(DebugCollectCoverage, 0, 1)                  \
+  F(DebugGetLoadedScriptIds, 0, 1)               \
+  F(DebugOnFunctionCall, 2, 1)                   \
+  F(DebugPopPromise, 0, 1)                       \
+  F(DebugPrepareStepInSuspendedGenerator, 0, 1)  \
+  F(DebugPromiseThen, 1, 1)                      \
+  F(DebugPushPromise, 1, 1)                      \
+  F(DebugToggleBlockCoverage, 1, 1)              \
+  F(DebugTogglePreciseCoverage, 1, 1)            \
+  F(FunctionGetInferredName, 1, 1)               \
+  F(GetBreakLocations, 1, 1)                     \
+  F(GetGeneratorScopeCount, 1, 1)                \
+  F(GetGeneratorScopeDetails, 2, 1)              \
+  F(HandleDebuggerStatement, 0, 1)               \
+  F(IsBreakOnException, 1, 1)                    \
+  F(LiveEditPatchScript, 2, 1)                   \
+  F(ProfileCreateSnapshotDataBlob, 0, 1)         \
+  F(ScheduleBreak, 0, 1)                         \
+  F(ScriptLocationFromLine2, 4, 1)               \
+  F(SetGeneratorScopeVariableValue, 4, 1)        \
+  I(IncBlockCounter, 2, 1)                       \
+  F(RecordReplayAssertExecutionProgress, 1, 1)   \
+  F(RecordReplayNotifyActivity, 0, 1)            \
+  F(RecordReplayAssertValue, 3, 1)               \
+  F(RecordReplayInstrumentation, 2, 1)           \
+  F(RecordReplayInstrumentationGenerator, 3, 1)  \
+  F(RecordReplayInstrumentationReturn, 3, 1)     \
+  F(RecordReplayTrackObjectId, 1, 1)             \
+  F(RecordReplayThrowJsFrameDepthOverflow, 0, 1)
 
 #define FOR_EACH_INTRINSIC_FORIN(F, I) \
   F(ForInEnumerate, 1, 1)              \
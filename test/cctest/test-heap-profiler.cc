@@ -30,6 +30,9 @@
 #include <ctype.h>
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "include/v8-function.h"
 #include "include/v8-profiler.h"
@@ -1218,6 +1221,192 @@ TEST(HeapSnapshotJSONSerialization) {
 }
 
 
+namespace {
+
+// The parts of a binary heap snapshot which are compared with the JSON
+// format.
+struct BinarySnapshot {
+  std::string snapshot;
+  std::vector<uint64_t> nodes;
+  std::vector<uint64_t> edges;
+  std::vector<std::string> strings;
+};
+
+class BinarySnapshotReader {
+ public:
+  explicit BinarySnapshotReader(v8::base::Vector<const char> data)
+      : data_(data) {}
+
+  uint64_t ReadVarint() {
+    uint64_t result = 0;
+    for (int shift = 0;; shift += 7) {
+      uint8_t byte = static_cast<uint8_t>(data_[pos_++]);
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (byte < 0x80) return result;
+    }
+  }
+
+  std::vector<uint64_t> ReadArray(size_t fields) {
+    size_t count = static_cast<size_t>(ReadVarint()) * fields;
+    std::vector<uint64_t> result(count);
+    for (size_t i = 0; i < count; i++) result[i] = ReadVarint();
+    return result;
+  }
+
+  std::string ReadBytes(size_t length) {
+    CHECK_LE(pos_ + length, data_.size());
+    std::string result(data_.begin() + pos_, length);
+    pos_ += length;
+    return result;
+  }
+
+  std::string ReadUntilNul() {
+    size_t start = pos_;
+    while (data_[pos_] != '\0') pos_++;
+    return std::string(data_.begin() + start, pos_++ - start);
+  }
+
+  void SkipTraceNode() {
+    for (int i = 0; i < 4; i++) ReadVarint();
+    uint64_t children = ReadVarint();
+    for (uint64_t i = 0; i < children; i++) SkipTraceNode();
+  }
+
+  bool done() const { return pos_ == data_.size(); }
+
+ private:
+  v8::base::Vector<const char> data_;
+  size_t pos_ = 0;
+};
+
+BinarySnapshot DecodeBinarySnapshot(v8::base::Vector<const char> data) {
+  BinarySnapshotReader reader(data);
+  CHECK(reader.ReadBytes(4) == "V8HS");
+  CHECK_EQ(1u, reader.ReadVarint());
+  BinarySnapshot result;
+  result.snapshot = reader.ReadUntilNul();
+  CHECK(!result.snapshot.empty());
+  result.nodes = reader.ReadArray(7);
+  result.edges = reader.ReadArray(3);
+  reader.ReadArray(6);  // trace_function_infos
+  reader.ReadArray(2);  // samples
+  reader.ReadArray(4);  // locations
+  if (reader.ReadVarint()) reader.SkipTraceNode();
+  uint64_t string_count = reader.ReadVarint();
+  for (uint64_t i = 0; i < string_count; i++) {
+    result.strings.push_back(
+        reader.ReadBytes(static_cast<size_t>(reader.ReadVarint())));
+  }
+  CHECK(reader.done());
+  return result;
+}
+
+v8::Local<v8::Array> GetParsedSnapshotArray(const char* name) {
+  return v8::Local<v8::Array>::Cast(
+      CompileRun((std::string("parsed_snapshot.") + name).c_str()));
+}
+
+// Serializes a snapshot in both formats and checks that the binary format has
+// the same nodes, edges and strings as the JSON format. Returns the sizes of
+// the JSON and binary outputs.
+std::pair<int, int> CheckBinarySnapshotMatchesJSON(
+    LocalContext* env, const v8::HeapSnapshot* snapshot) {
+  v8::Isolate* isolate = (*env)->GetIsolate();
+  v8::Local<v8::Context> context = env->local();
+
+  TestJSONStream json_stream;
+  snapshot->Serialize(&json_stream, v8::HeapSnapshot::kJSON);
+  CHECK_EQ(1, json_stream.eos_signaled());
+  v8::base::ScopedVector<char> json(json_stream.size());
+  json_stream.WriteTo(json);
+
+  TestJSONStream binary_stream;
+  snapshot->Serialize(&binary_stream, v8::HeapSnapshot::kBinary);
+  CHECK_EQ(1, binary_stream.eos_signaled());
+  v8::base::ScopedVector<char> binary(binary_stream.size());
+  binary_stream.WriteTo(binary);
+  BinarySnapshot decoded = DecodeBinarySnapshot(
+      v8::base::Vector<const char>(binary.begin(), binary.length()));
+
+  (*env)
+      ->Global()
+      ->Set(context, v8_str("json_snapshot"),
+            v8::String::NewExternalOneByte(isolate, new OneByteResource(json))
+                .ToLocalChecked())
+      .FromJust();
+  (*env)
+      ->Global()
+      ->Set(context, v8_str("binary_snapshot_meta"),
+            v8_str(("{" + decoded.snapshot + "}").c_str()))
+      .FromJust();
+  CHECK(CompileRun("var parsed_snapshot = JSON.parse(json_snapshot);\n"
+                   "JSON.stringify(parsed_snapshot.snapshot) ==="
+                   "    JSON.stringify(JSON.parse(binary_snapshot_meta));")
+            ->IsTrue());
+
+  v8::Local<v8::Array> nodes = GetParsedSnapshotArray("nodes");
+  CHECK_EQ(decoded.nodes.size(), static_cast<size_t>(nodes->Length()));
+  for (uint32_t i = 0; i < nodes->Length(); i++) {
+    double value =
+        nodes->Get(context, i).ToLocalChecked().As<v8::Number>()->Value();
+    CHECK_EQ(value, static_cast<double>(decoded.nodes[i]));
+  }
+
+  v8::Local<v8::Array> edges = GetParsedSnapshotArray("edges");
+  CHECK_EQ(decoded.edges.size(), static_cast<size_t>(edges->Length()));
+  for (uint32_t i = 0; i < edges->Length(); i++) {
+    double value =
+        edges->Get(context, i).ToLocalChecked().As<v8::Number>()->Value();
+    CHECK_EQ(value, static_cast<double>(decoded.edges[i]));
+  }
+
+  v8::Local<v8::Array> strings = GetParsedSnapshotArray("strings");
+  CHECK_EQ(decoded.strings.size(), static_cast<size_t>(strings->Length()));
+  for (uint32_t i = 0; i < strings->Length(); i++) {
+    v8::String::Utf8Value value(isolate,
+                                strings->Get(context, i).ToLocalChecked());
+    CHECK(decoded.strings[i] == std::string(*value, value.length()));
+  }
+
+  return {json.length(), binary.length()};
+}
+
+}  // namespace
+
+TEST(HeapSnapshotBinarySerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A(\"String \\n\\r\\u0008\\u0081\\u0101\\u0801\\u8001\");\n"
+      "var b = new B(a);");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  CheckBinarySnapshotMatchesJSON(&env, snapshot);
+}
+
+TEST(HeapSnapshotBinarySerializationLargeHeap) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Enough objects and distinct strings that most of the output is nodes,
+  // edges and strings rather than the snapshot metadata.
+  CompileRun(
+      "var objects = [];\n"
+      "for (var i = 0; i < 100000; i++) {\n"
+      "  objects.push({index: i, name: 'object' + i, next: objects[i - 1]});\n"
+      "}");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  std::pair<int, int> sizes = CheckBinarySnapshotMatchesJSON(&env, snapshot);
+  // Varints are smaller than formatted decimal numbers and separators.
+  CHECK_LT(sizes.second, sizes.first);
+}
+
 TEST(HeapSnapshotJSONSerializationAborting) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
@@ -1615,6 +1804,70 @@ TEST(TakeHeapSnapshotReportFinishOnce) {
 
 namespace {
 
+void CheckSameEdgeName(const v8::HeapGraphEdge* a, const v8::HeapGraphEdge* b) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::String::Utf8Value a_name(isolate, a->GetName());
+  v8::String::Utf8Value b_name(isolate, b->GetName());
+  CHECK_EQ(0, strcmp(*a_name, *b_name));
+}
+
+// Checks that two snapshots of the same heap have the same nodes and edges,
+// in the same order.
+void CheckSameSnapshot(const v8::HeapSnapshot* a, const v8::HeapSnapshot* b) {
+  CHECK_EQ(a->GetNodesCount(), b->GetNodesCount());
+  for (int i = 0; i < a->GetNodesCount(); i++) {
+    const v8::HeapGraphNode* a_node = a->GetNode(i);
+    const v8::HeapGraphNode* b_node = b->GetNode(i);
+    CHECK_EQ(a_node->GetType(), b_node->GetType());
+    CHECK_EQ(a_node->GetId(), b_node->GetId());
+    CHECK_EQ(a_node->GetShallowSize(), b_node->GetShallowSize());
+    CHECK(a_node->GetName()->StrictEquals(b_node->GetName()));
+    CHECK_EQ(a_node->GetChildrenCount(), b_node->GetChildrenCount());
+    for (int j = 0; j < a_node->GetChildrenCount(); j++) {
+      const v8::HeapGraphEdge* a_edge = a_node->GetChild(j);
+      const v8::HeapGraphEdge* b_edge = b_node->GetChild(j);
+      CHECK_EQ(a_edge->GetType(), b_edge->GetType());
+      CheckSameEdgeName(a_edge, b_edge);
+      CHECK_EQ(a_edge->GetToNode()->GetId(), b_edge->GetToNode()->GetId());
+    }
+  }
+}
+
+}  // namespace
+
+TEST(HeapSnapshotParallelMatchesSerial) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "var objects = [];\n"
+      "for (var i = 0; i < 20000; i++) {\n"
+      "  objects.push(new A('string' + i));\n"
+      "}\n"
+      "var map = new Map(objects.map((o, i) => [i, o]));\n"
+      "var weak = new WeakMap([[objects[0], objects[1]]]);");
+
+  // Anything lazily created by taking a snapshot exists before the snapshots
+  // which are compared.
+  CHECK(ValidateSnapshot(heap_profiler->TakeHeapSnapshot()));
+
+  i::v8_flags.parallel_heap_snapshot = false;
+  const v8::HeapSnapshot* serial = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(serial));
+
+  i::v8_flags.parallel_heap_snapshot = true;
+  TestActivityControl control(-1);  // Don't abort.
+  const v8::HeapSnapshot* parallel = heap_profiler->TakeHeapSnapshot(&control);
+  CHECK(ValidateSnapshot(parallel));
+  CHECK_EQ(control.total(), control.done());
+
+  CheckSameSnapshot(serial, parallel);
+}
+
+namespace {
+
 class EmbedderGraphBuilder : public v8::PersistentHandleVisitor {
  public:
   class Node : public v8::EmbedderGraph::Node {
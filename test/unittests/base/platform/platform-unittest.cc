@@ -157,6 +157,56 @@ TEST(OS, GetSharedLibraryAddresses) {
   EXPECT_EQ(shared_library_addresses[1].start, 0x12430000u - 0x62000);
 #endif
 }
+
+TEST(OS, PreferredNumaNode) {
+  EXPECT_LE(1, OS::NumberOfNumaNodes());
+  const int node = OS::GetCurrentNumaNode();
+  if (node < 0) GTEST_SKIP() << "Current NUMA node is unknown";
+  EXPECT_LT(node, OS::NumberOfNumaNodes());
+
+  const size_t size = OS::AllocatePageSize();
+  void* data = OS::Allocate(nullptr, size, OS::AllocatePageSize(),
+                            OS::MemoryPermission::kReadWrite);
+  ASSERT_TRUE(data);
+  if (OS::SetPreferredNumaNode(data, size, node)) {
+    // Pages are placed when first touched.
+    memset(data, 0xab, size);
+    const int actual_node = OS::GetNumaNodeOfAddress(data);
+    // move_pages may not be permitted, e.g. in sandboxes.
+    if (actual_node >= 0) EXPECT_EQ(node, actual_node);
+  }
+  OS::Free(data, size);
+}
+
+TEST(OS, TransparentHugePages) {
+  EXPECT_EQ(0u, OS::GetHugePageBackedSize({}));
+  const size_t huge_page_size = OS::HugePageSize();
+  if (huge_page_size == 0) {
+    GTEST_SKIP() << "Transparent huge pages are not supported";
+  }
+  EXPECT_EQ(0u, huge_page_size % OS::CommitPageSize());
+
+  const size_t size = 2 * huge_page_size;
+  void* data = OS::Allocate(nullptr, size, huge_page_size,
+                            OS::MemoryPermission::kReadWrite);
+  ASSERT_TRUE(data);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(data) % huge_page_size);
+  const uintptr_t start = reinterpret_cast<uintptr_t>(data);
+
+  // Ranges without a whole huge page in them can't be advised.
+  EXPECT_FALSE(OS::AdviseHugePages(data, huge_page_size / 2));
+  EXPECT_FALSE(OS::AdviseHugePages(
+      reinterpret_cast<void*>(start + OS::CommitPageSize()), huge_page_size));
+  EXPECT_TRUE(OS::AdviseHugePages(data, size));
+
+  memset(data, 0xab, size);
+  // Whether the kernel actually uses huge pages depends on its configuration
+  // and on available memory, so only the bounds can be checked.
+  const std::vector<OS::MemoryRange> ranges = {{start, start + size}};
+  const size_t backed_size = OS::GetHugePageBackedSize(ranges);
+  EXPECT_LE(backed_size, size);
+  OS::Free(data, size);
+}
 #endif  // V8_TARGET_OS_LINUX
 
 namespace {
@@ -0,0 +1,86 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/collection-barrier.h"
+
+#include "src/base/platform/elapsed-timer.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/time.h"
+#include "src/heap/heap.h"
+#include "src/heap/local-heap.h"
+#include "src/heap/parked-scope.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using CollectionBarrierTest = TestWithIsolate;
+
+namespace {
+
+// Requests a GC from a background thread and waits for it, optionally with a
+// timeout.
+class AwaitingThread final : public v8::base::Thread {
+ public:
+  AwaitingThread(Heap* heap, base::TimeDelta timeout)
+      : v8::base::Thread(base::Thread::Options("AwaitingThread")),
+        heap_(heap),
+        timeout_(timeout) {}
+
+  void Run() override {
+    LocalHeap lh(heap_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&lh);
+    CollectionBarrier* barrier = heap_->collection_barrier();
+    CHECK(barrier->TryRequestGC());
+    performed_gc_ = timeout_.IsMax()
+                        ? barrier->AwaitCollectionBackground(&lh)
+                        : barrier->AwaitCollectionBackground(&lh, timeout_);
+  }
+
+  bool performed_gc() const { return performed_gc_; }
+
+ private:
+  Heap* heap_;
+  base::TimeDelta timeout_;
+  bool performed_gc_ = true;
+};
+
+}  // anonymous namespace
+
+TEST_F(CollectionBarrierTest, TimedAwaitReturnsWithGCStillRequested) {
+  Heap* heap = i_isolate()->heap();
+  const base::TimeDelta timeout = base::TimeDelta::FromMilliseconds(1);
+  auto thread = std::make_unique<AwaitingThread>(heap, timeout);
+  base::ElapsedTimer timer;
+  timer.Start();
+  CHECK(thread->Start());
+  // The main thread doesn't perform the GC, so the wait times out.
+  thread->Join();
+  EXPECT_GE(timer.Elapsed().InMicroseconds(), timeout.InMicroseconds());
+  EXPECT_FALSE(thread->performed_gc());
+  EXPECT_TRUE(heap->CollectionRequested());
+
+  heap->CheckCollectionRequested();
+  EXPECT_FALSE(heap->CollectionRequested());
+}
+
+TEST_F(CollectionBarrierTest, BlockedMainThreadResumesWaiters) {
+  Heap* heap = i_isolate()->heap();
+  auto thread = std::make_unique<AwaitingThread>(heap, base::TimeDelta::Max());
+  CHECK(thread->Start());
+  // The waiter returns without a timeout whether it starts waiting before or
+  // after the main thread blocks.
+  heap->SetMainThreadWaitingOnOrderedLock(true);
+  thread->Join();
+  EXPECT_FALSE(thread->performed_gc());
+  EXPECT_TRUE(heap->CollectionRequested());
+  heap->SetMainThreadWaitingOnOrderedLock(false);
+
+  heap->CheckCollectionRequested();
+  EXPECT_FALSE(heap->CollectionRequested());
+}
+
+}  // namespace internal
+}  // namespace v8
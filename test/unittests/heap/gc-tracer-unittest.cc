@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <limits>
+#include <string>
 
 #include "src/base/platform/platform.h"
 #include "src/common/globals.h"
@@ -561,5 +562,39 @@ TEST_F(GCTracerTest, RecordScavengerHistograms) {
   GcHistogram::CleanUp();
 }
 
+TEST_F(GCTracerTest, ScavengerTaskStats) {
+  if (v8_flags.stress_incremental_marking) return;
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  StartTracing(tracer, GarbageCollector::SCAVENGER, StartTracingMode::kAtomic);
+  tracer->AddScavengerTaskStats(3, 100);
+  tracer->AddScavengerTaskStats(5, 50);
+  tracer->AddScavengerTaskStats(1, 200);
+  StopTracing(tracer, GarbageCollector::SCAVENGER);
+  EXPECT_EQ(3, tracer->current_.scavenger_tasks);
+  EXPECT_DOUBLE_EQ(5, tracer->current_.scavenger_task_max_duration);
+  EXPECT_DOUBLE_EQ(9, tracer->current_.scavenger_task_total_duration);
+  EXPECT_EQ(200u, tracer->current_.scavenger_task_max_bytes);
+
+  testing::internal::CaptureStdout();
+  tracer->PrintNVP();
+  std::string nvp = testing::internal::GetCapturedStdout();
+  EXPECT_NE(std::string::npos, nvp.find(" scavenge.parallel.tasks=3 "));
+  EXPECT_NE(std::string::npos, nvp.find(" scavenge.parallel.task_max=5.00 "));
+  EXPECT_NE(std::string::npos,
+            nvp.find(" scavenge.parallel.task_total=9.00 "));
+  EXPECT_NE(std::string::npos,
+            nvp.find(" scavenge.parallel.task_max_bytes=200 "));
+
+  // The next scavenge starts counting from scratch.
+  StartTracing(tracer, GarbageCollector::SCAVENGER, StartTracingMode::kAtomic);
+  tracer->AddScavengerTaskStats(2, 10);
+  StopTracing(tracer, GarbageCollector::SCAVENGER);
+  EXPECT_EQ(1, tracer->current_.scavenger_tasks);
+  EXPECT_DOUBLE_EQ(2, tracer->current_.scavenger_task_max_duration);
+  EXPECT_DOUBLE_EQ(2, tracer->current_.scavenger_task_total_duration);
+  EXPECT_EQ(10u, tracer->current_.scavenger_task_max_bytes);
+}
+
 }  // namespace internal
 }  // namespace v8
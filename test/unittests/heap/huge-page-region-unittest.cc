@@ -0,0 +1,153 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/memory-allocator.h"
+#include "src/heap/spaces-inl.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Turns on --transparent-huge-pages before the isolate's memory allocator is
+// created.
+template <typename TMixin>
+class WithTransparentHugePagesMixin : public TMixin {
+ public:
+  WithTransparentHugePagesMixin()
+      : old_flag_(v8_flags.transparent_huge_pages) {
+    v8_flags.transparent_huge_pages = true;
+  }
+  ~WithTransparentHugePagesMixin() override {
+    v8_flags.transparent_huge_pages = old_flag_;
+  }
+
+ private:
+  const bool old_flag_;
+};
+
+}  // namespace
+
+class HugePageRegionTest : public                                        //
+                           WithInternalIsolateMixin<                     //
+                               WithIsolateScopeMixin<                    //
+                                   WithIsolateMixin<                     //
+                                       WithTransparentHugePagesMixin<    //
+                                           WithDefaultPlatformMixin<     //
+                                               ::testing::Test>>>>> {
+ public:
+  MemoryAllocator* allocator() { return isolate()->heap()->memory_allocator(); }
+
+  static size_t PagesPerRegion() {
+    return base::OS::HugePageSize() / MemoryChunk::kPageSize;
+  }
+
+  // Pages are only grouped if a huge page holds several of them.
+  static bool UsesRegions() { return PagesPerRegion() >= 2; }
+
+  static Address RegionStart(Page* page) {
+    return RoundDown(page->address(), base::OS::HugePageSize());
+  }
+
+  bool HasRegion(Address start) {
+    std::vector<base::OS::MemoryRange> ranges;
+    allocator()->AddHugePageRanges(&ranges);
+    for (const base::OS::MemoryRange& range : ranges) {
+      if (range.start == start) return true;
+    }
+    return false;
+  }
+
+  Page* AllocatePage() {
+    Page* page = allocator()->AllocatePage(
+        MemoryAllocator::AllocationMode::kRegular,
+        static_cast<PagedSpace*>(isolate()->heap()->old_space()),
+        Executability::NOT_EXECUTABLE);
+    CHECK_NOT_NULL(page);
+    return page;
+  }
+
+  void FreePage(Page* page) {
+    allocator()->Free(MemoryAllocator::FreeMode::kImmediately, page);
+  }
+};
+
+TEST_F(HugePageRegionTest, FillAndReleaseRegion) {
+  if (v8_flags.enable_third_party_heap) return;
+  if (!UsesRegions()) GTEST_SKIP() << "Old space pages aren't grouped";
+  const size_t pages_per_region = PagesPerRegion();
+
+  // Regions the heap already uses may have free pages. Fill them up until a
+  // page lands in a new region.
+  std::vector<base::OS::MemoryRange> initial_ranges;
+  allocator()->AddHugePageRanges(&initial_ranges);
+  std::vector<Page*> other_pages;
+  Page* first_page = nullptr;
+  while (first_page == nullptr) {
+    Page* page = AllocatePage();
+    EXPECT_TRUE(allocator()->IsInHugePageRegion(page));
+    bool in_initial_region = false;
+    for (const base::OS::MemoryRange& range : initial_ranges) {
+      if (range.start == RegionStart(page)) in_initial_region = true;
+    }
+    if (in_initial_region) {
+      other_pages.push_back(page);
+    } else {
+      first_page = page;
+    }
+  }
+
+  // All other regions are full, so the new region is filled next.
+  const Address region_start = RegionStart(first_page);
+  std::vector<Page*> region_pages = {first_page};
+  while (region_pages.size() < pages_per_region) {
+    Page* page = AllocatePage();
+    EXPECT_EQ(region_start, RegionStart(page));
+    region_pages.push_back(page);
+  }
+  // The full region is skipped. A region is released as soon as its only
+  // page is freed.
+  Page* next_page = AllocatePage();
+  const Address next_region_start = RegionStart(next_page);
+  EXPECT_NE(region_start, next_region_start);
+  FreePage(next_page);
+  EXPECT_FALSE(HasRegion(next_region_start));
+
+  // Freeing part of the region keeps it and makes its pages reusable.
+  const size_t freed_pages = pages_per_region / 2;
+  std::vector<Address> freed_addresses;
+  for (size_t i = 0; i < freed_pages; i++) {
+    freed_addresses.push_back(region_pages.back()->address());
+    FreePage(region_pages.back());
+    region_pages.pop_back();
+    EXPECT_TRUE(HasRegion(region_start));
+  }
+  Page* reused_page = AllocatePage();
+  EXPECT_EQ(region_start, RegionStart(reused_page));
+  EXPECT_NE(freed_addresses.end(),
+            std::find(freed_addresses.begin(), freed_addresses.end(),
+                      reused_page->address()));
+  region_pages.push_back(reused_page);
+
+  // The region is released together with its last page.
+  while (region_pages.size() > 1) {
+    FreePage(region_pages.back());
+    region_pages.pop_back();
+    EXPECT_TRUE(HasRegion(region_start));
+  }
+  FreePage(region_pages.back());
+  EXPECT_FALSE(HasRegion(region_start));
+
+  for (Page* page : other_pages) FreePage(page);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,44 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/scavenger.h"
+
+#include "test/common/flag-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+TEST(ScavengerTest, NumberOfScavengeTasksScalesWithWork) {
+  FlagScope<int> max_tasks(&v8_flags.scavenger_max_task_num, 0);
+  // A small new space and no old-to-new pages only need one task.
+  EXPECT_EQ(1, ScavengerCollector::NumberOfScavengeTasks(0, 0, 8));
+  EXPECT_EQ(1, ScavengerCollector::NumberOfScavengeTasks(MB - 1, 3, 8));
+  // One more task per MB of new space and per 4 pages with old-to-new slots.
+  EXPECT_EQ(3, ScavengerCollector::NumberOfScavengeTasks(2 * MB, 0, 8));
+  EXPECT_EQ(3, ScavengerCollector::NumberOfScavengeTasks(0, 8, 8));
+  EXPECT_EQ(5, ScavengerCollector::NumberOfScavengeTasks(2 * MB, 8, 8));
+}
+
+TEST(ScavengerTest, NumberOfScavengeTasksIsCapped) {
+  FlagScope<int> max_tasks(&v8_flags.scavenger_max_task_num, 0);
+  // Capped by the number of cores...
+  EXPECT_EQ(8, ScavengerCollector::NumberOfScavengeTasks(64 * MB, 0, 8));
+  EXPECT_EQ(1, ScavengerCollector::NumberOfScavengeTasks(64 * MB, 64, 1));
+  // ... and by kMaxScavengerTasks.
+  EXPECT_EQ(ScavengerCollector::kMaxScavengerTasks,
+            ScavengerCollector::NumberOfScavengeTasks(256 * MB, 1024, 1024));
+}
+
+TEST(ScavengerTest, NumberOfScavengeTasksRespectsMaxTaskNum) {
+  FlagScope<int> max_tasks(&v8_flags.scavenger_max_task_num, 2);
+  EXPECT_EQ(2, ScavengerCollector::NumberOfScavengeTasks(64 * MB, 0, 8));
+  EXPECT_EQ(2, ScavengerCollector::NumberOfScavengeTasks(0, 64, 8));
+  // The flag only lowers the limit.
+  EXPECT_EQ(1, ScavengerCollector::NumberOfScavengeTasks(64 * MB, 0, 1));
+  EXPECT_EQ(1, ScavengerCollector::NumberOfScavengeTasks(0, 0, 8));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -19,9 +19,11 @@
 #include "include/v8-wasm.h"
 #include "src/api/api-inl.h"
 #include "src/base/build_config.h"
+#include "src/heap/factory-inl.h"
 #include "src/objects/backing-store.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/objects-inl.h"
+#include "src/utils/memcopy.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -644,6 +646,53 @@ TEST_F(ValueSerializerTest, RoundTripString) {
   EXPECT_EQ(kEmojiString, Utf8Value(value));
 }
 
+TEST_F(ValueSerializerTest, CanonicalEncoding) {
+  // The canonical encoding used when recording or replaying only depends on
+  // values, not on how they are represented in the heap.
+  i::Isolate* isolate = i_isolate();
+  auto encode = [&](i::Handle<i::Object> object) {
+    Context::Scope scope(serialization_context());
+    i::ValueSerializer serializer(isolate, nullptr);
+    serializer.SetCanonicalEncodingForTesting();
+    serializer.WriteHeader();
+    CHECK(serializer.WriteObject(object).FromMaybe(false));
+    std::pair<uint8_t*, size_t> buffer = serializer.Release();
+    std::vector<uint8_t> result(buffer.first, buffer.first + buffer.second);
+    free(buffer.first);
+    return result;
+  };
+
+  // A heap number holding an int32 is written as an int32.
+  i::Handle<i::HeapNumber> number = isolate->factory()->NewHeapNumber(-42);
+  std::vector<uint8_t> encoded = encode(number);
+  ASSERT_EQ(4u, encoded.size());
+  EXPECT_EQ(0x49, encoded[2]);  // Int32
+  EXPECT_EQ(0x53, encoded[3]);  // ZigZag(-42)
+  Local<Value> value = DecodeTest(encoded);
+  ASSERT_TRUE(value->IsInt32());
+  EXPECT_EQ(-42, Int32::Cast(*value)->Value());
+
+  // A two-byte string whose contents fit in Latin-1 is written as a one-byte
+  // string.
+  static const base::uc16 kChars[] = {'Q', 'u', 0xE9, 'b', 'e', 'c'};
+  i::Handle<i::SeqTwoByteString> string =
+      isolate->factory()
+          ->NewRawTwoByteString(arraysize(kChars))
+          .ToHandleChecked();
+  {
+    i::DisallowGarbageCollection no_gc;
+    i::CopyChars(string->GetChars(no_gc), kChars, arraysize(kChars));
+  }
+  encoded = encode(string);
+  EXPECT_EQ((std::vector<uint8_t>{0xFF, 0x0F, 0x22, 0x06, 'Q', 'u', 0xE9, 'b',
+                                  'e', 'c'}),
+            encoded);
+  value = DecodeTest(encoded);
+  ASSERT_TRUE(value->IsString());
+  EXPECT_EQ(6, String::Cast(*value)->Length());
+  EXPECT_EQ(kQuebecString, Utf8Value(value));
+}
+
 TEST_F(ValueSerializerTest, DecodeString) {
   // Decoding the strings above from UTF-8.
   DecodeTestFutureVersions({0xFF, 0x09, 0x53, 0x00}, [](Local<Value> value) {
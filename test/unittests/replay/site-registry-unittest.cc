@@ -0,0 +1,196 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/replay/site-registry.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace replayio {
+
+namespace {
+
+struct TestSite {
+  size_t thread = 0;
+  size_t value = 0;
+};
+
+using TestRegistry = SiteRegistry<TestSite>;
+
+class AddSitesThread final : public base::Thread {
+ public:
+  AddSitesThread(TestRegistry* registry, size_t thread, size_t count)
+      : base::Thread(Options("AddSitesThread")),
+        registry_(registry),
+        thread_(thread),
+        count_(count) {}
+
+  void Run() override {
+    for (size_t i = 0; i < count_; i++) {
+      size_t index = registry_->Add({thread_, i});
+      indexes_.push_back(index);
+      // Sites added by this thread are visible as soon as Add returns.
+      TestSite* site = registry_->TryGet(index);
+      CHECK_NOT_NULL(site);
+      CHECK_EQ(site->thread, thread_);
+      CHECK_EQ(site->value, i);
+    }
+  }
+
+  const std::vector<size_t>& indexes() const { return indexes_; }
+
+ private:
+  TestRegistry* registry_;
+  size_t thread_;
+  size_t count_;
+  std::vector<size_t> indexes_;
+};
+
+class ReadSitesThread final : public base::Thread {
+ public:
+  explicit ReadSitesThread(TestRegistry* registry)
+      : base::Thread(Options("ReadSitesThread")), registry_(registry) {}
+
+  void Run() override {
+    // Sites can be looked up while other threads are adding them. Any site
+    // which is found must have been completely written.
+    while (!done_.load(std::memory_order_relaxed)) {
+      size_t limit = registry_->ReservedCount();
+      for (size_t index = 0; index < limit; index++) {
+        TestSite* site = registry_->TryGet(index);
+        if (site) {
+          CHECK_LT(site->thread, kMaxThreads);
+        }
+      }
+    }
+  }
+
+  void Stop() { done_.store(true, std::memory_order_relaxed); }
+
+  static constexpr size_t kMaxThreads = 8;
+
+ private:
+  TestRegistry* registry_;
+  std::atomic<bool> done_{false};
+};
+
+}  // namespace
+
+TEST(SiteRegistry, AddAndGet) {
+  auto registry = std::make_unique<TestRegistry>("Test");
+  EXPECT_EQ(0u, registry->ReservedCount());
+  EXPECT_EQ(nullptr, registry->TryGet(0));
+
+  for (size_t i = 0; i < 3 * TestRegistry::kSegmentSize; i++) {
+    // Indexes are assigned in order when sites are added from one thread.
+    EXPECT_EQ(i, registry->Add({0, i}));
+  }
+  EXPECT_EQ(3 * TestRegistry::kSegmentSize, registry->ReservedCount());
+
+  for (size_t i = 0; i < 3 * TestRegistry::kSegmentSize; i++) {
+    TestSite* site = registry->TryGet(i);
+    ASSERT_NE(nullptr, site);
+    EXPECT_EQ(i, site->value);
+  }
+  EXPECT_EQ(nullptr, registry->TryGet(3 * TestRegistry::kSegmentSize));
+  EXPECT_EQ(nullptr, registry->TryGet(TestRegistry::kMaxSites));
+
+  // Adding one more site reserves a whole new block.
+  EXPECT_EQ(3 * TestRegistry::kSegmentSize, registry->Add({0, 0}));
+  EXPECT_EQ(4 * TestRegistry::kSegmentSize, registry->ReservedCount());
+  EXPECT_EQ(nullptr, registry->TryGet(3 * TestRegistry::kSegmentSize + 1));
+}
+
+TEST(SiteRegistry, GrowBeyondFirstChunk) {
+  // Segments are found through chunks which are allocated as the registry
+  // grows, so there is no low limit on the number of sites.
+  auto registry = std::make_unique<TestRegistry>("Test");
+  const size_t kSites =
+      (TestRegistry::kSegmentsPerChunk + 1) * TestRegistry::kSegmentSize;
+  for (size_t i = 0; i < kSites; i++) {
+    ASSERT_EQ(i, registry->Add({0, i}));
+  }
+  for (size_t i = 0; i < kSites; i += TestRegistry::kSegmentSize - 1) {
+    TestSite* site = registry->TryGet(i);
+    ASSERT_NE(nullptr, site);
+    EXPECT_EQ(i, site->value);
+  }
+  EXPECT_EQ(nullptr, registry->TryGet(kSites));
+  EXPECT_EQ(nullptr, registry->TryGet(TestRegistry::kMaxSites - 1));
+}
+
+TEST(SiteRegistry, SeparateRegistries) {
+  // Blocks reserved by a thread belong to one registry, even when a new
+  // registry takes the place of a deleted one.
+  for (size_t i = 0; i < 2; i++) {
+    auto registry = std::make_unique<TestRegistry>("Test");
+    auto other_registry = std::make_unique<TestRegistry>("Other");
+    EXPECT_EQ(0u, registry->Add({0, 0}));
+    EXPECT_EQ(0u, other_registry->Add({0, 1}));
+    // Switching back to the first registry reserves a new block.
+    EXPECT_EQ(TestRegistry::kSegmentSize, registry->Add({0, 2}));
+    EXPECT_EQ(2u, registry->TryGet(TestRegistry::kSegmentSize)->value);
+    EXPECT_EQ(nullptr, registry->TryGet(1));
+    EXPECT_EQ(1u, other_registry->TryGet(0)->value);
+    EXPECT_EQ(nullptr, other_registry->TryGet(1));
+  }
+}
+
+TEST(SiteRegistry, ConcurrentAddAndGet) {
+  constexpr size_t kThreads = ReadSitesThread::kMaxThreads;
+  constexpr size_t kSitesPerThread = TestRegistry::kSegmentSize + 100;
+  auto registry = std::make_unique<TestRegistry>("Test");
+
+  ReadSitesThread reader(registry.get());
+  CHECK(reader.Start());
+
+  std::vector<std::unique_ptr<AddSitesThread>> threads;
+  for (size_t i = 0; i < kThreads; i++) {
+    threads.push_back(
+        std::make_unique<AddSitesThread>(registry.get(), i, kSitesPerThread));
+  }
+  for (auto& thread : threads) CHECK(thread->Start());
+  for (auto& thread : threads) thread->Join();
+  reader.Stop();
+  reader.Join();
+
+  // Each thread filled one block and started a second one.
+  const size_t reserved = registry->ReservedCount();
+  EXPECT_EQ(2 * kThreads * TestRegistry::kSegmentSize, reserved);
+
+  // Every index is handed out at most once, and indexes which weren't handed
+  // out have no site.
+  std::vector<bool> seen(reserved, false);
+  for (size_t i = 0; i < kThreads; i++) {
+    const std::vector<size_t>& indexes = threads[i]->indexes();
+    ASSERT_EQ(kSitesPerThread, indexes.size());
+    for (size_t j = 0; j < indexes.size(); j++) {
+      size_t index = indexes[j];
+      ASSERT_LT(index, reserved);
+      EXPECT_FALSE(seen[index]);
+      seen[index] = true;
+
+      TestSite* site = registry->TryGet(index);
+      ASSERT_NE(nullptr, site);
+      EXPECT_EQ(i, site->thread);
+      EXPECT_EQ(j, site->value);
+
+      // Indexes increase in the order each thread added its sites, and are
+      // consecutive within a block.
+      if (j) EXPECT_LT(indexes[j - 1], index);
+      if (j % TestRegistry::kSegmentSize) EXPECT_EQ(indexes[j - 1] + 1, index);
+    }
+  }
+  for (size_t index = 0; index < reserved; index++) {
+    if (!seen[index]) EXPECT_EQ(nullptr, registry->TryGet(index));
+  }
+}
+
+}  // namespace replayio
+}  // namespace v8
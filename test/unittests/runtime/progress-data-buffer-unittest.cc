@@ -0,0 +1,148 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/replay/progress-data-buffer.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+std::vector<uint64_t> AddAll(ProgressDataBuffer* buffer,
+                             const std::vector<uint64_t>& entries) {
+  for (uint64_t entry : entries) buffer->Add(entry);
+  return entries;
+}
+
+std::vector<uint64_t> TakeEntries(ProgressDataBuffer* buffer) {
+  std::vector<uint8_t> bytes = buffer->Take();
+  return ProgressDataBuffer::Decode(bytes.data(), bytes.size());
+}
+
+// Distinct entries which are far apart, so each one is written as its own run
+// with a long delta.
+std::vector<uint64_t> ScatteredEntries(size_t count) {
+  std::vector<uint64_t> entries;
+  for (uint64_t i = 0; i < count; i++) {
+    entries.push_back((i + 1) * 0x9e3779b97f4a7c15ull);
+  }
+  return entries;
+}
+
+}  // namespace
+
+TEST(ProgressDataBufferTest, RoundTripsDeltas) {
+  ProgressDataBuffer buffer;
+  EXPECT_TRUE(buffer.empty());
+  const std::vector<uint64_t> entries = AddAll(
+      &buffer, {0, 1, 100, 5, 5, 0, UINT64_MAX, 1, UINT64_MAX / 2,
+                UINT64_MAX / 2 + 1, 3, 127, 128, 16383, 16384, 0});
+  EXPECT_FALSE(buffer.empty());
+  EXPECT_EQ(entries, TakeEntries(&buffer));
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_TRUE(TakeEntries(&buffer).empty());
+}
+
+TEST(ProgressDataBufferTest, EncodesRunsCompactly) {
+  constexpr uint64_t kRunLength = 1000000;
+  ProgressDataBuffer buffer;
+  std::vector<uint64_t> entries;
+  for (uint64_t entry : {42ull, 7ull, 42ull}) {
+    for (uint64_t i = 0; i < kRunLength; i++) {
+      buffer.Add(entry);
+      entries.push_back(entry);
+    }
+  }
+  std::vector<uint8_t> bytes = buffer.Take();
+  // One byte for each delta and three for each run length.
+  EXPECT_EQ(3u * (1 + 3), bytes.size());
+  EXPECT_EQ(entries, ProgressDataBuffer::Decode(bytes.data(), bytes.size()));
+}
+
+TEST(ProgressDataBufferTest, EqualSequencesHaveEqualEncodings) {
+  ProgressDataBuffer first;
+  ProgressDataBuffer second;
+  AddAll(&first, {1, 1, 2, 3, 3, 3});
+  // Taking the data starts the encoding over, as in a new buffer.
+  first.Take();
+  AddAll(&first, {1, 1, 2, 3, 3, 3});
+  AddAll(&second, {1, 1, 2, 3, 3, 3});
+  EXPECT_EQ(first.Take(), second.Take());
+}
+
+TEST(ProgressDataBufferTest, ResetToMark) {
+  ProgressDataBuffer buffer;
+  AddAll(&buffer, {1, 2, 2});
+  RecordReplayProgressDataMark mark = buffer.Mark();
+  AddAll(&buffer, {2, 2, 9, 4});
+  buffer.Reset(mark);
+  buffer.ReleaseMark();
+  // The run in progress at the mark continues as before.
+  AddAll(&buffer, {2, 5});
+  EXPECT_EQ(std::vector<uint64_t>({1, 2, 2, 2, 5}), TakeEntries(&buffer));
+}
+
+TEST(ProgressDataBufferTest, ResetToMarkFromEarlierEpoch) {
+  ProgressDataBuffer buffer;
+  AddAll(&buffer, {1, 2});
+  RecordReplayProgressDataMark mark = buffer.Mark();
+  AddAll(&buffer, {3});
+  EXPECT_EQ(std::vector<uint64_t>({1, 2, 3}), TakeEntries(&buffer));
+  // Everything added since the contents were taken is discarded.
+  AddAll(&buffer, {4, 4});
+  buffer.Reset(mark);
+  buffer.ReleaseMark();
+  EXPECT_TRUE(buffer.empty());
+  // Entries are relative to zero again.
+  AddAll(&buffer, {5});
+  EXPECT_EQ(std::vector<uint64_t>({5}), TakeEntries(&buffer));
+}
+
+TEST(ProgressDataBufferTest, DropsOldestRunsPastLimit) {
+  // Each entry takes more than ten bytes, so this goes past the limit once.
+  const size_t count = ProgressDataBuffer::kMaxEncodedSize / 10 + 1000;
+  ProgressDataBuffer buffer;
+  const std::vector<uint64_t> entries =
+      AddAll(&buffer, ScatteredEntries(count));
+  std::vector<uint8_t> bytes = buffer.Take();
+  EXPECT_LT(bytes.size(), ProgressDataBuffer::kMaxEncodedSize);
+  std::vector<uint64_t> kept =
+      ProgressDataBuffer::Decode(bytes.data(), bytes.size());
+  ASSERT_LT(kept.size(), entries.size());
+  EXPECT_GT(kept.size(), entries.size() / 4);
+  // The newest entries are kept.
+  EXPECT_EQ(std::vector<uint64_t>(entries.end() - kept.size(), entries.end()),
+            kept);
+}
+
+TEST(ProgressDataBufferTest, MarksDeferDropping) {
+  const size_t count = ProgressDataBuffer::kMaxEncodedSize / 10 + 1000;
+  const std::vector<uint64_t> entries = ScatteredEntries(count);
+  ProgressDataBuffer buffer;
+  AddAll(&buffer, {1, 2});
+  RecordReplayProgressDataMark mark = buffer.Mark();
+  AddAll(&buffer, entries);
+  // Nothing is dropped while the mark is outstanding, so resetting to it is
+  // exact.
+  buffer.Reset(mark);
+  EXPECT_EQ(std::vector<uint64_t>({1, 2}), TakeEntries(&buffer));
+  AddAll(&buffer, entries);
+  EXPECT_EQ(entries, TakeEntries(&buffer));
+
+  // Once the mark is released the oldest runs are dropped again.
+  buffer.ReleaseMark();
+  AddAll(&buffer, entries);
+  std::vector<uint64_t> kept = TakeEntries(&buffer);
+  EXPECT_LT(kept.size(), entries.size());
+  EXPECT_EQ(std::vector<uint64_t>(entries.end() - kept.size(), entries.end()),
+            kept);
+}
+
+}  // namespace internal
+}  // namespace v8
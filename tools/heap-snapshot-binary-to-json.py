@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+#
+# Converts a heap snapshot written with v8::HeapSnapshot::kBinary into the
+# JSON format used by DevTools (.heapsnapshot files). See the description
+# near v8::HeapSnapshot::Serialize for the layout of both formats.
+#
+# Usage: heap-snapshot-binary-to-json.py <input> [<output>]
+#
+
+import json
+import sys
+
+MAGIC = b'V8HS'
+VERSION = 1
+
+NODE_FIELDS = 7
+EDGE_FIELDS = 3
+TRACE_FUNCTION_INFO_FIELDS = 6
+SAMPLE_FIELDS = 2
+LOCATION_FIELDS = 4
+
+
+class Reader(object):
+
+  def __init__(self, data):
+    self.data = data
+    self.pos = 0
+
+  def varint(self):
+    result = 0
+    shift = 0
+    while True:
+      byte = self.data[self.pos]
+      self.pos += 1
+      result |= (byte & 0x7f) << shift
+      if byte < 0x80:
+        return result
+      shift += 7
+
+  def varints(self, count):
+    return [self.varint() for _ in range(count)]
+
+  def array(self, fields):
+    return self.varints(self.varint() * fields)
+
+  def bytes(self, length):
+    result = self.data[self.pos:self.pos + length]
+    self.pos += length
+    return result
+
+  def until_nul(self):
+    end = self.data.index(b'\0', self.pos)
+    result = self.data[self.pos:end]
+    self.pos = end + 1
+    return result
+
+
+def read_trace_node(reader):
+  node = reader.varints(4)
+  children = []
+  for _ in range(reader.varint()):
+    children.extend(read_trace_node(reader))
+  node.append(children)
+  return node
+
+
+def write_numbers(out, name, numbers, fields):
+  out.write('"%s":[' % name)
+  for i in range(0, len(numbers), fields):
+    if i > 0:
+      out.write(',')
+    out.write(','.join(map(str, numbers[i:i + fields])))
+    out.write('\n')
+  out.write('],\n')
+
+
+def convert(data, out):
+  reader = Reader(data)
+  if reader.bytes(len(MAGIC)) != MAGIC:
+    raise Exception('Not a binary heap snapshot')
+  version = reader.varint()
+  if version != VERSION:
+    raise Exception('Unsupported binary heap snapshot version %d' % version)
+
+  snapshot = reader.until_nul().decode('utf-8')
+  if not snapshot:
+    # Snapshots were disabled when this was written.
+    out.write('{}')
+    return
+
+  nodes = reader.array(NODE_FIELDS)
+  edges = reader.array(EDGE_FIELDS)
+  trace_function_infos = reader.array(TRACE_FUNCTION_INFO_FIELDS)
+  samples = reader.array(SAMPLE_FIELDS)
+  locations = reader.array(LOCATION_FIELDS)
+  trace_tree = read_trace_node(reader) if reader.varint() else []
+  strings = [
+      reader.bytes(reader.varint()).decode('utf-8', 'replace')
+      for _ in range(reader.varint())
+  ]
+
+  out.write('{"snapshot":{%s},\n' % snapshot)
+  write_numbers(out, 'nodes', nodes, NODE_FIELDS)
+  write_numbers(out, 'edges', edges, EDGE_FIELDS)
+  write_numbers(out, 'trace_function_infos', trace_function_infos,
+                TRACE_FUNCTION_INFO_FIELDS)
+  out.write('"trace_tree":%s,\n' % json.dumps(trace_tree, separators=(',', ':')))
+  write_numbers(out, 'samples', samples, SAMPLE_FIELDS)
+  write_numbers(out, 'locations', locations, LOCATION_FIELDS)
+  out.write('"strings":[')
+  out.write(',\n'.join(json.dumps(s) for s in strings))
+  out.write(']}')
+
+
+def main(argv):
+  if len(argv) not in (2, 3):
+    print('Usage: %s <input> [<output>]' % argv[0], file=sys.stderr)
+    return 1
+  with open(argv[1], 'rb') as f:
+    data = f.read()
+  if len(argv) == 3:
+    with open(argv[2], 'w') as out:
+      convert(data, out)
+  else:
+    convert(data, sys.stdout)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))